@@ -0,0 +1,298 @@
+#include "CorpusGenerator.h"
+#include <nlohmann/json.hpp>
+#include <zlib.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace {
+
+// Minimal ZIP writer: local headers, then the central directory and its end record
+class ZipWriter {
+public:
+    void addStored(std::string_view name, std::string_view content) {
+        add(name, content, content, 0);
+    }
+
+    void addDeflated(std::string_view name, std::string_view content) {
+        add(name, content, deflateRaw(content), 8);
+    }
+
+    std::string finish() {
+        const auto directoryOffset = static_cast<uint32_t>(out.size());
+
+        for (const auto& record : records) {
+            put32(0x02014b50);
+            put16(20);                          // version made by
+            put16(20);                          // version needed
+            put16(0);                           // flags
+            put16(record.method);
+            put16(0);                           // mod time
+            put16(0x21);                        // mod date (1980-01-01)
+            put32(record.crc);
+            put32(record.compressedSize);
+            put32(record.uncompressedSize);
+            put16(static_cast<uint16_t>(record.name.size()));
+            put16(0);                           // extra length
+            put16(0);                           // comment length
+            put16(0);                           // disk number
+            put16(0);                           // internal attributes
+            put32(0);                           // external attributes
+            put32(record.offset);
+            out += record.name;
+        }
+
+        const auto directorySize = static_cast<uint32_t>(out.size()) - directoryOffset;
+
+        put32(0x06054b50);
+        put16(0);
+        put16(0);
+        put16(static_cast<uint16_t>(records.size()));
+        put16(static_cast<uint16_t>(records.size()));
+        put32(directorySize);
+        put32(directoryOffset);
+        put16(0);
+
+        return std::move(out);
+    }
+
+private:
+    struct Record {
+        std::string name;
+        uint32_t crc = 0;
+        uint32_t compressedSize = 0;
+        uint32_t uncompressedSize = 0;
+        uint32_t offset = 0;
+        uint16_t method = 0;
+    };
+
+    std::string out;
+    std::vector<Record> records;
+
+    void add(std::string_view name, std::string_view content, std::string_view payload, uint16_t method) {
+        Record record;
+        record.name = std::string(name);
+        record.crc = static_cast<uint32_t>(crc32(0L, reinterpret_cast<const Bytef*>(content.data()),
+                                                 static_cast<uInt>(content.size())));
+        record.compressedSize = static_cast<uint32_t>(payload.size());
+        record.uncompressedSize = static_cast<uint32_t>(content.size());
+        record.offset = static_cast<uint32_t>(out.size());
+        record.method = method;
+
+        put32(0x04034b50);
+        put16(20);
+        put16(0);
+        put16(method);
+        put16(0);
+        put16(0x21);
+        put32(record.crc);
+        put32(record.compressedSize);
+        put32(record.uncompressedSize);
+        put16(static_cast<uint16_t>(name.size()));
+        put16(0);
+        out += name;
+        out += payload;
+
+        records.push_back(std::move(record));
+    }
+
+    static std::string deflateRaw(std::string_view content) {
+        z_stream stream = {};
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+
+        std::string compressed(deflateBound(&stream, static_cast<uLong>(content.size())), '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(content.data()));
+        stream.avail_in = static_cast<uInt>(content.size());
+        stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+        stream.avail_out = static_cast<uInt>(compressed.size());
+
+        deflate(&stream, Z_FINISH);
+        compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+
+        return compressed;
+    }
+
+    void put16(uint16_t value) {
+        out += static_cast<char>(value & 0xFF);
+        out += static_cast<char>(value >> 8);
+    }
+
+    void put32(uint32_t value) {
+        put16(static_cast<uint16_t>(value & 0xFFFF));
+        put16(static_cast<uint16_t>(value >> 16));
+    }
+};
+
+std::string packageFor(const std::string& modId) {
+    std::string package = "com/example/" + modId;
+    std::ranges::replace(package, '-', '_');
+    return package;
+}
+
+// Bytes that look enough like a class file: magic, version and some incompressible noise
+std::string fakeClass(std::mt19937& rng) {
+    std::string bytes("\xCA\xFE\xBA\xBE\x00\x00\x00\x41", 8);
+    std::uniform_int_distribution<int> length(200, 2000);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    const int size = length(rng);
+    for (int i = 0; i < size; ++i) {
+        bytes += static_cast<char>(byte(rng) < 96 ? 'A' + byte(rng) % 26 : byte(rng));
+    }
+    return bytes;
+}
+
+std::string nestedLibraryJar(const std::string& libraryId, const std::string& containerId) {
+    const json modJson = {
+        {"schemaVersion", 1},
+        {"id", libraryId},
+        {"version", "1.0.0+" + containerId},
+        {"name", "Library " + libraryId},
+        {"depends", {{"fabricloader", ">=0.15.0"}}}
+    };
+
+    ZipWriter jar;
+    jar.addDeflated("fabric.mod.json", modJson.dump(2));
+    jar.addDeflated(packageFor(libraryId) + "/Library.class", "\xCA\xFE\xBA\xBE library " + libraryId);
+    return jar.finish();
+}
+
+} // namespace
+
+std::string CorpusGenerator::modIdFor(size_t index) {
+    std::string id = std::to_string(index);
+    return "bench-mod-" + std::string(id.size() < 5 ? 5 - id.size() : 0, '0') + id;
+}
+
+size_t CorpusGenerator::generate(const fs::path& modsDir) {
+    std::error_code ec;
+    fs::create_directories(modsDir, ec);
+    if (ec) {
+        std::cerr << "Cannot create " << modsDir << ": " << ec.message() << std::endl;
+        return 0;
+    }
+
+    static constexpr const char* LOCALIZED_PREFIXES[] = {
+        "Mod", "Modification", "Мод", "モッド", "Modifikation", "Módulo"
+    };
+    static constexpr const char* ENVIRONMENTS[] = {"*", "*", "*", "client", "server"};
+
+    std::mt19937 rng(options.seed);
+    bytesWritten = 0;
+    size_t written = 0;
+
+    for (size_t index = 0; index < options.modCount; ++index) {
+        const std::string modId = modIdFor(index);
+        const std::string package = packageFor(modId);
+
+        json modJson = {
+            {"schemaVersion", 1},
+            {"id", modId},
+            {"version", std::to_string(1 + index % 7) + "." + std::to_string(index % 13) + ".0"},
+            {"name", std::string(LOCALIZED_PREFIXES[index % std::size(LOCALIZED_PREFIXES)]) + " " + std::to_string(index)},
+            {"description", "Synthetic mod " + std::to_string(index) + " generated for benchmarking.\n"
+                            "It adds nothing, but its metadata looks like a real mod's."},
+            {"authors", json::array({"Bench Author", {{"name", "Contributor " + std::to_string(index % 17)}}})},
+            {"contact", {
+                {"homepage", "https://example.com/" + modId},
+                {"sources", "https://example.com/" + modId + "/source"},
+                {"issues", "https://example.com/" + modId + "/issues"}
+            }},
+            {"license", index % 3 == 0 ? "MIT" : "LGPL-3.0-only"},
+            {"icon", "assets/" + modId + "/icon.png"},
+            {"environment", ENVIRONMENTS[index % std::size(ENVIRONMENTS)]},
+            {"entrypoints", {{"main", {package + "/Main"}}}},
+            {"mixins", {modId + ".mixins.json"}},
+            {"custom", {{"modmenu", {{"name_translations", {
+                {"de_de", "Modifikation " + std::to_string(index)},
+                {"ja_jp", "モッド " + std::to_string(index)},
+                {"ru_ru", "Мод " + std::to_string(index)}
+            }}}}}}
+        };
+
+        // Dependencies only point at earlier mods, which keeps the graph acyclic like most packs
+        json depends = {{"fabricloader", ">=0.15.0"}, {"minecraft", "~1.20.1"}};
+        if (index > 0 && options.maxDependencies > 0) {
+            std::uniform_int_distribution<size_t> dependencyCount(0, options.maxDependencies);
+            std::uniform_int_distribution<size_t> target(0, index - 1);
+            for (size_t d = dependencyCount(rng); d > 0; --d) {
+                depends[modIdFor(target(rng))] = "*";
+            }
+        }
+        // Some mods need a library that only ships inside another mod's JAR
+        if (options.nestedEvery > 0 && index > options.nestedEvery && index % 4 == 1) {
+            const size_t container = (index / 2) / options.nestedEvery * options.nestedEvery;
+            depends[modIdFor(container) + "-api"] = ">=1.0.0";
+        }
+        modJson["depends"] = depends;
+
+        json suggests = json::object();
+        suggests["modmenu"] = "*";
+        if (index + 1 < options.modCount) {
+            suggests[modIdFor(index + 1)] = ">=1.0.0";
+        }
+        modJson["suggests"] = suggests;
+
+        ZipWriter jar;
+
+        std::vector<std::string> nestedIds;
+        if (options.nestedEvery > 0 && index % options.nestedEvery == 0) {
+            nestedIds.push_back(modId + "-api");
+            if (index % (options.nestedEvery * 2) == 0) {
+                nestedIds.push_back(modId + "-config");
+            }
+
+            json jars = json::array();
+            for (const auto& nestedId : nestedIds) {
+                jars.push_back({{"file", "META-INF/jars/" + nestedId + ".jar"}});
+            }
+            modJson["jars"] = jars;
+        }
+
+        jar.addStored("META-INF/MANIFEST.MF", "Manifest-Version: 1.0\r\n\r\n");
+        jar.addDeflated("fabric.mod.json", modJson.dump(2));
+        jar.addDeflated(modId + ".mixins.json", json{
+            {"required", true},
+            {"package", "com.example." + package.substr(12) + ".mixin"},
+            {"compatibilityLevel", "JAVA_17"},
+            {"mixins", {"EntityMixin", "WorldMixin"}}
+        }.dump(2));
+
+        // Icons are already compressed, so JARs usually store them
+        std::string icon = "\x89PNG\r\n\x1A\n";
+        icon.append(256 + index % 512, static_cast<char>(index));
+        jar.addStored("assets/" + modId + "/icon.png", icon);
+
+        for (size_t c = 0; c < options.classesPerMod; ++c) {
+            const std::string name = package + "/Class" + std::to_string(c) + ".class";
+            if (c % 5 == 4) {
+                jar.addStored(name, fakeClass(rng));
+            } else {
+                jar.addDeflated(name, fakeClass(rng));
+            }
+        }
+
+        for (const auto& nestedId : nestedIds) {
+            jar.addStored("META-INF/jars/" + nestedId + ".jar", nestedLibraryJar(nestedId, modId));
+        }
+
+        const std::string bytes = jar.finish();
+        std::ofstream file(modsDir / (modId + ".jar"), std::ios::binary);
+        if (!file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()))) {
+            std::cerr << "Failed to write " << modId << ".jar" << std::endl;
+            continue;
+        }
+
+        bytesWritten += bytes.size();
+        written++;
+    }
+
+    return written;
+}
@@ -0,0 +1,42 @@
+#ifndef FABRICBINARYSEARCH_CORPUSGENERATOR_H
+#define FABRICBINARYSEARCH_CORPUSGENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+struct CorpusOptions {
+    size_t modCount = 100;
+
+    // Fake .class entries per mod; roughly sets the size of each central directory
+    size_t classesPerMod = 16;
+
+    // Every Nth mod bundles jar-in-jar libraries (0 = none)
+    size_t nestedEvery = 8;
+
+    size_t maxDependencies = 4;
+    uint32_t seed = 42;
+};
+
+// Writes a deterministic set of synthetic Fabric mod JARs for benchmarking. The mods have
+// realistic fabric.mod.json files (depends, suggests, localized names, mixins, jar-in-jar)
+// and mix stored and deflated entries the way real JARs do.
+class CorpusGenerator {
+public:
+    explicit CorpusGenerator(const CorpusOptions& options) : options(options) {}
+
+    // Fills modsDir (created if needed) and returns the number of JAR files written
+    size_t generate(const fs::path& modsDir);
+
+    [[nodiscard]] uintmax_t getBytesWritten() const { return bytesWritten; }
+
+    static std::string modIdFor(size_t index);
+
+private:
+    CorpusOptions options;
+    uintmax_t bytesWritten = 0;
+};
+
+#endif // FABRICBINARYSEARCH_CORPUSGENERATOR_H
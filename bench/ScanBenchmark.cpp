@@ -0,0 +1,236 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+#include <unordered_set>
+#include "CorpusGenerator.h"
+#include "ModManager.h"
+#include "ModCache.h"
+#include "ToggleJournal.h"
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+namespace fs = std::filesystem;
+
+struct BenchOptions {
+    std::vector<size_t> sizes = {10, 100, 1000, 10000};
+    size_t classesPerMod = 16;
+    unsigned threads = 0;
+    int repeats = 5;
+    bool keep = false;
+    fs::path workDir = fs::temp_directory_path() / "fabric-binary-search-bench";
+};
+
+// Swallows ModManager's per-JAR console output while a step is being timed
+class QuietStdout {
+public:
+    QuietStdout() : previous(std::cout.rdbuf(&sink)) {}
+    ~QuietStdout() { std::cout.rdbuf(previous); }
+
+    QuietStdout(const QuietStdout&) = delete;
+    QuietStdout& operator=(const QuietStdout&) = delete;
+
+private:
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return traits_type::not_eof(c); }
+    };
+
+    NullBuffer sink;
+    std::streambuf* previous;
+};
+
+template <typename Fn>
+double timeSeconds(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Peak resident set size of this process so far, in KiB
+size_t peakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+void printRow(const std::string& step, size_t items, double seconds) {
+    std::cout << "  " << std::left << std::setw(26) << step
+              << std::right << std::setw(8) << items
+              << std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms"
+              << std::setw(14) << std::setprecision(0) << (seconds > 0 ? items / seconds : 0.0) << " mods/s"
+              << std::endl;
+}
+
+bool runSize(size_t modCount, const BenchOptions& options) {
+    const fs::path sizeDir = options.workDir / ("corpus-" + std::to_string(modCount));
+    const fs::path modsDir = sizeDir / "mods";
+
+    std::error_code ec;
+    fs::remove_all(sizeDir, ec);
+
+    CorpusOptions corpusOptions;
+    corpusOptions.modCount = modCount;
+    corpusOptions.classesPerMod = options.classesPerMod;
+
+    CorpusGenerator generator(corpusOptions);
+    size_t written = 0;
+    const double generateTime = timeSeconds([&] { written = generator.generate(modsDir); });
+    if (written != modCount) {
+        std::cerr << "Generated " << written << " of " << modCount << " JARs" << std::endl;
+        return false;
+    }
+
+    std::cout << "\n=== " << modCount << " mods (" << std::fixed << std::setprecision(1)
+              << generator.getBytesWritten() / (1024.0 * 1024.0) << " MiB, generated in "
+              << std::setprecision(2) << generateTime << " s) ===" << std::endl;
+
+    // Keep the user's scan cache and toggle journal out of it
+    ModCache::getInstance().setCachePath(sizeDir / "mod-cache.json");
+    ToggleJournal::getInstance().setJournalPath(sizeDir / "toggle-journal.log");
+
+    std::string modsPath = modsDir.string();
+    ModManager manager(modsPath);
+    manager.setScanThreads(options.threads);
+
+    bool scanned = false;
+    const double coldScan = timeSeconds([&] {
+        QuietStdout quiet;
+        scanned = manager.scanMods();
+    });
+    if (!scanned || manager.getMods().size() != modCount) {
+        std::cerr << "Scan found " << manager.getMods().size() << " of " << modCount << " mods" << std::endl;
+        return false;
+    }
+    printRow("scanMods (no cache)", modCount, coldScan);
+
+    const double cachedScan = timeSeconds([&] {
+        QuietStdout quiet;
+        manager.scanMods();
+    });
+    printRow("scanMods (cached)", modCount, cachedScan);
+
+    size_t enabledCount = 0;
+    const double enabledTime = timeSeconds([&] {
+        for (int i = 0; i < options.repeats; ++i) {
+            enabledCount += manager.getEnabledModIds().size();
+        }
+    });
+    printRow("getEnabledModIds", enabledCount / options.repeats, enabledTime / options.repeats);
+
+    // The first half is what a binary search step keeps enabled
+    std::unordered_set<std::string> keep;
+    for (size_t i = 0; i < modCount / 2; ++i) {
+        keep.insert(manager.getMods()[i].id);
+    }
+
+    const double disableTime = timeSeconds([&] {
+        QuietStdout quiet;
+        manager.disableAllExcept(keep);
+    });
+    printRow("disableAllExcept (half)", modCount, disableTime);
+
+    const double enableTime = timeSeconds([&] {
+        QuietStdout quiet;
+        manager.enableAllMods();
+    });
+    printRow("enableAllMods", modCount, enableTime);
+
+    std::cout << "  Peak RSS so far: " << peakRssKb() / 1024 << " MiB" << std::endl;
+
+    if (!options.keep) {
+        fs::remove_all(sizeDir, ec);
+    }
+    return true;
+}
+
+void printUsage() {
+    std::cout << "Usage: FabricBinarySearchBench [options]\n"
+              << "  --sizes <n,n,...>   Mod counts to benchmark (default 10,100,1000,10000)\n"
+              << "  --classes <n>       Fake class files per mod (default 16)\n"
+              << "  --threads <n>       Scan threads, 0 = one per core (default 0)\n"
+              << "  --repeats <n>       Repetitions of the cheap queries (default 5)\n"
+              << "  --dir <path>        Where to generate the corpus (default: system temp)\n"
+              << "  --keep              Leave the generated mods directories in place\n";
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "--sizes" && hasValue) {
+                options.sizes.clear();
+                std::string list = argv[++i];
+                for (size_t start = 0; start <= list.size();) {
+                    const size_t comma = std::min(list.find(',', start), list.size());
+                    options.sizes.push_back(std::stoul(list.substr(start, comma - start)));
+                    start = comma + 1;
+                }
+            } else if (arg == "--classes" && hasValue) {
+                options.classesPerMod = std::stoul(argv[++i]);
+            } else if (arg == "--threads" && hasValue) {
+                options.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            } else if (arg == "--repeats" && hasValue) {
+                options.repeats = std::max(1, std::stoi(argv[++i]));
+            } else if (arg == "--dir" && hasValue) {
+                options.workDir = argv[++i];
+            } else if (arg == "--keep") {
+                options.keep = true;
+            } else {
+                printUsage();
+                return arg == "--help" || arg == "-h" ? 0 : 1;
+            }
+        }
+    } catch (const std::exception&) {
+        printUsage();
+        return 1;
+    }
+
+    std::cout << "Corpus: " << options.workDir.string() << std::endl;
+    std::cout << "Note: \"no cache\" means no scan cache; the generated files are still in the page cache."
+              << std::endl;
+
+    bool ok = true;
+    for (const size_t size : options.sizes) {
+        try {
+            ok = runSize(size, options) && ok;
+        } catch (const std::exception& e) {
+            std::cerr << "Benchmark for " << size << " mods failed: " << e.what() << std::endl;
+            ok = false;
+        }
+    }
+
+    // Only removed if empty, in case --dir pointed somewhere with other contents
+    std::error_code ec;
+    fs::remove(options.workDir, ec);
+
+    return ok ? 0 : 1;
+}
@@ -2,9 +2,14 @@
 #define FABRICBINARYSEARCH_BINARYSEARCHENGINE_H
 
 #include "ModManager.h"
+#include "DeltaDebugger.h"
+#include "GroupTester.h"
+#include "CrashLogParser.h"
+#include "TestInstances.h"
 #include <vector>
 #include <unordered_set>
 #include <string>
+#include <algorithm>
 
 enum class TestResult {
     SUCCESS,
@@ -12,6 +17,19 @@ enum class TestResult {
     UNKNOWN
 };
 
+enum class SearchStrategy {
+    // Halve the suspects each test; finds one culprit
+    BISECT,
+    // ddmin; finds a minimal set of mods that only cause the problem together
+    DELTA_DEBUG,
+    // Group testing; finds every mod that causes the problem on its own
+    ALL_CULPRITS,
+    // Like BISECT, but splits by how likely each mod is to be the culprit given the crash log
+    LIKELY_FIRST,
+    // Splits into k+1 groups each round and tests k of them at once in separate game directories
+    PARALLEL
+};
+
 enum class SearchState {
     NOT_STARTED,
     IN_PROGRESS,
@@ -23,12 +41,33 @@ class BinarySearchEngine {
 public:
     explicit BinarySearchEngine(ModManager& manager);
 
+    // Takes effect at the next startSearch()
+    void setStrategy(SearchStrategy newStrategy) { strategy = newStrategy; }
+
+    [[nodiscard]] SearchStrategy getStrategy() const { return strategy; }
+
+    // Crash log whose suspects LIKELY_FIRST tests first; takes effect at the next startSearch()
+    void setCrashEvidence(const CrashInfo& info) { crashEvidence = info; }
+
+    // How many game instances PARALLEL runs per round; takes effect at the next startSearch()
+    void setParallelism(size_t instances) { parallelism = std::max<size_t>(instances, 1); }
+
+    [[nodiscard]] size_t getParallelism() const { return parallelism; }
+
     void startSearch();
 
     bool nextIteration();
 
     void reportResult(TestResult result);
 
+    // One result per pending test, in the order of getTestGameDirectories()
+    void reportResults(const std::vector<TestResult>& results);
+
+    [[nodiscard]] size_t getPendingTestCount() const { return pendingConfigs.size(); }
+
+    // With PARALLEL, the game directory prepared for each pending test
+    [[nodiscard]] std::vector<fs::path> getTestGameDirectories() const;
+
     [[nodiscard]] bool isComplete() const;
 
     [[nodiscard]] std::vector<std::string> getCulprits() const;
@@ -37,22 +76,81 @@ public:
 
     [[nodiscard]] std::string getProgressReport() const;
 
-    [[nodiscard]] const std::vector<std::string>& getSuspects() const { return suspects; }
+    // Suspect mod IDs in mod list order
+    [[nodiscard]] std::vector<std::string> getSuspects() const { return idsOf(suspects); }
+
+    [[nodiscard]] size_t getSuspectCount() const { return suspects.count(); }
 
     void reset();
 
 private:
     ModManager& modManager;
     SearchState state;
+    SearchStrategy strategy = SearchStrategy::BISECT;
 
-    std::vector<std::string> allMods;
-    std::vector<std::string> suspects;
-    std::vector<std::string> innocent;
-    std::vector<std::string> currentlyDisabled;
+    // Handles into modManager.getMods(); only valid while its mod list version is modListVersion
+    ModBitset allMods;
+    ModBitset suspects;
+    ModBitset innocent;
+    ModBitset currentlyEnabled;
+    uint64_t modListVersion = 0;
 
     int iteration;
 
-    void splitSuspects(std::vector<std::string>& half1, std::vector<std::string>& half2);
+    // With DELTA_DEBUG, suspects mirrors its current failing set
+    DeltaDebugger deltaDebugger;
+
+    bool nextDeltaDebugIteration();
+
+    // With ALL_CULPRITS, suspects mirrors its remaining suspects until it completes
+    GroupTester groupTester;
+
+    bool nextGroupTestIteration();
+
+    std::optional<CrashInfo> crashEvidence;
+
+    // With LIKELY_FIRST, the probability of each mod being the culprit, indexed by handle.
+    // Test results are taken as certain, so updating it only zeroes the cleared mods.
+    std::vector<double> posterior;
+
+    void computePriors();
+
+    void updatePosterior();
+
+    // The split (with its dependencies) whose result is expected to tell the most
+    [[nodiscard]] EnablePlan planLikelySplit() const;
+
+    [[nodiscard]] double probabilityOf(const ModBitset& handles) const;
+
+    size_t parallelism = 4;
+
+    // What each test waiting on a result enables; one entry except with PARALLEL
+    std::vector<ModBitset> pendingConfigs;
+
+    std::optional<TestInstances> testInstances;
+
+    bool nextParallelIteration();
+
+    // Narrows the suspects by each result; false once the search has ended
+    bool applyResults(const std::vector<TestResult>& results);
+
+    // Enables exactly what the plan says and asks the user to test
+    void applyTestPlan(const EnablePlan& plan);
+
+    // Suspects with everything a mod needs before it and dependency cycles kept together, so
+    // any prefix enables no other suspect
+    [[nodiscard]] std::vector<ModHandle> dependencyOrder() const;
+
+    // half1 is the first half of dependencyOrder()
+    void splitSuspects(ModBitset& half1, ModBitset& half2) const;
+
+    // Keeps the prefix of dependencyOrder() whose plan enables closest to `target` suspects
+    [[nodiscard]] std::optional<EnablePlan> planBalancedSplit(size_t target) const;
+
+    [[nodiscard]] std::vector<std::string> idsOf(const ModBitset& handles) const;
+
+    // Fails the search if a rescan or watcher update has renumbered the mods
+    bool checkModList();
 };
 
 #endif // FABRICBINARYSEARCH_BINARYSEARCHENGINE_H
\ No newline at end of file
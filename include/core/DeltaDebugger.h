@@ -0,0 +1,71 @@
+#ifndef FABRICBINARYSEARCH_DELTADEBUGGER_H
+#define FABRICBINARYSEARCH_DELTADEBUGGER_H
+
+#include "ModBitset.h"
+#include <functional>
+#include <optional>
+#include <vector>
+
+// ddmin (Zeller & Hildebrandt) over mod handles, one test at a time: next() proposes the
+// mods to request, and the caller reports how the game behaved with them. It ends with a
+// 1-minimal failing set: the problem goes away if any single one of those mods is removed.
+//
+// A request is widened by `closure` (dependencies) before it is tested. Tests whose outcome
+// already follows from earlier ones are skipped: a configuration inside one that passed is
+// assumed to pass, and one containing the smallest failing configuration to fail. Once the
+// set is 1-minimal, each mod in it is tried replaced by its dependencies, so the result
+// names the mod that matters rather than one that merely depends on it.
+class DeltaDebugger {
+public:
+    using Closure = std::function<ModBitset(const ModBitset&)>;
+
+    // `failing` is the set of mods known to show the problem when all are enabled
+    void start(const ModBitset& failing, Closure closure);
+
+    // Mods to request for the next test, or nullopt once the failing set is 1-minimal
+    [[nodiscard]] std::optional<ModBitset> next();
+
+    void reportFailure();
+
+    void reportSuccess();
+
+    // The configuration could not be tested (e.g. the game did not start for another reason)
+    void reportUnresolved();
+
+    // Smallest set so far whose configuration shows the problem
+    [[nodiscard]] const ModBitset& getFailing() const { return failing; }
+
+    [[nodiscard]] size_t getGranularity() const { return granularity; }
+
+private:
+    ModBitset failing;
+    ModBitset failingConfig;
+    Closure closure;
+
+    // `failing` split into `granularity` parts; subsets are tried first, then complements
+    size_t granularity = 2;
+    std::vector<ModBitset> parts;
+    size_t partIndex = 0;
+    bool testingComplements = false;
+
+    // Mods the search started from, and those shown to matter themselves, not their dependencies
+    ModBitset universe;
+    ModBitset confirmed;
+
+    std::optional<ModBitset> pending;
+    std::optional<ModHandle> pendingPushDown;
+    std::vector<ModBitset> passedConfigs;
+
+    // Moves past the pending test without shrinking the failing set
+    void advance();
+
+    void split();
+
+    void reduceTo(const ModBitset& candidate, const ModBitset& config);
+
+    [[nodiscard]] bool isKnownToPass(const ModBitset& config) const;
+
+    [[nodiscard]] ModBitset candidateAt(size_t index) const;
+};
+
+#endif // FABRICBINARYSEARCH_DELTADEBUGGER_H
@@ -0,0 +1,72 @@
+#ifndef FABRICBINARYSEARCH_GROUPTESTER_H
+#define FABRICBINARYSEARCH_GROUPTESTER_H
+
+#include "ModBitset.h"
+#include <functional>
+#include <optional>
+
+// Adaptive group testing (Hwang's generalized binary splitting) for several independent
+// culprits, each of which causes the problem on its own. Groups of about n/d suspects are
+// tested with every mod cleared so far enabled; a passing group is cleared, a failing one
+// is halved down to its culprit. Found culprits stay disabled and everything learned carries
+// over to the next culprit, so finding d of n mods takes about d*log2(n/d) tests.
+class GroupTester {
+public:
+    // Mods actually enabled for a request, with the culprits found so far kept disabled
+    using Planner = std::function<ModBitset(const ModBitset& requested, const ModBitset& culprits)>;
+
+    // `failing` is the set of mods known to show the problem when all are enabled
+    void start(const ModBitset& failing, Planner planner);
+
+    // Mods to request for the next test, or nullopt once every suspect is cleared or found.
+    // A test with no result reported yet is repeated as it was.
+    [[nodiscard]] std::optional<ModBitset> next();
+
+    // The last test gave no answer; the next call to next() repeats it
+    void reportUnresolved() {}
+
+    void reportFailure();
+
+    void reportSuccess();
+
+    [[nodiscard]] const ModBitset& getSuspects() const { return suspects; }
+
+    [[nodiscard]] const ModBitset& getCulprits() const { return culprits; }
+
+    // Suspects that cannot be loaded without a culprit, so were never tested on their own
+    [[nodiscard]] const ModBitset& getBlocked() const { return blocked; }
+
+private:
+    enum class Phase {
+        // Does anything still cause the problem?
+        CHECK_REST,
+        // Find a failing group of about n/d suspects
+        GROUPS,
+        // Halve the failing group down to one culprit
+        SPLIT
+    };
+
+    Planner planner;
+
+    Phase phase = Phase::CHECK_REST;
+    ModBitset suspects;
+    ModBitset innocent;
+    ModBitset culprits;
+    ModBitset blocked;
+
+    // Known to contain at least one culprit while splitting
+    ModBitset contaminated;
+
+    // Suspects the pending test enables, and what it requested
+    std::optional<ModBitset> pendingTested;
+    std::optional<ModBitset> pendingRequest;
+
+    // Plans a test of `group` with the cleared mods; false if none of it could be enabled
+    bool propose(const ModBitset& group, std::optional<ModBitset>& request);
+
+    void addCulprits(const ModBitset& found);
+
+    [[nodiscard]] size_t groupSize() const;
+};
+
+#endif // FABRICBINARYSEARCH_GROUPTESTER_H
@@ -2,36 +2,122 @@
 #define FABRICBINARYSEARCH_MODMANAGER_H
 
 #include "ModInfo.h"
+#include "ModCache.h"
+#include "JarReader.h"
+#include "ClassIndex.h"
+#include "ModBitset.h"
+#include "ModTable.h"
+#include "DependencyGraph.h"
+#include "ModSetFarm.h"
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <filesystem>
+#include <optional>
 
 namespace fs = std::filesystem;
 
+// A set of mods to enable that is closed under dependencies in both directions: every enabled
+// mod has what it needs, and nothing enabled needs a mod that must stay disabled
+struct EnablePlan {
+    struct Change {
+        ModHandle mod;
+        ModHandle because;
+    };
+
+    ModBitset enabled;
+
+    // Not asked for, but needed by `because`, which is enabled
+    std::vector<Change> pulledIn;
+
+    // Asked for, but needs `because`, which has to stay disabled
+    std::vector<Change> pushedOut;
+};
+
 class ModManager {
 public:
     explicit ModManager(std::string& modsDirectory);
 
     bool scanMods();
 
+    // Number of worker threads used by scanMods (0 = one per core, 1 = serial)
+    void setScanThreads(unsigned threads) { scanThreads = threads; }
+
     [[nodiscard]] const std::vector<ModInfo>& getMods() const { return mods; }
 
+    // Compact copy of getMods() for per-frame and per-iteration work, indexed by handle
+    [[nodiscard]] const ModTable& getModTable() const { return modTable; }
+
+    // Mods bundled as jar-in-jar; each names its top-level container in providedBy
+    [[nodiscard]] const std::vector<ModInfo>& getProvidedMods() const { return providedMods; }
+
     [[nodiscard]] const ModInfo* getModById(const std::string& modId) const;
 
+    // Handles index getMods() and are reassigned whenever the mod list changes (scan or
+    // incremental update); getModListVersion() changes with them
+    [[nodiscard]] std::optional<ModHandle> findHandle(const std::string& modId) const;
+
+    [[nodiscard]] uint64_t getModListVersion() const { return modListVersion; }
+
+    // Incremental updates for a single file in the mods directory (see ModWatcher).
+    // Each re-reads at most the affected JAR; they return false if nothing changed.
+    bool applyJarAdded(const fs::path& filePath);
+
+    bool applyJarRemoved(const fs::path& filePath);
+
+    bool applyJarRenamed(const fs::path& fromPath, const fs::path& toPath);
+
+    // Class -> owning mod lookup over every scanned JAR, built on first use after a scan
+    [[nodiscard]] const ClassIndex& getClassIndex() const;
+
+    // ID of the top-level mod whose JAR supplies modId, which may be a nested mod or a
+    // `provides` alias (modId itself if it is top-level or unknown)
+    [[nodiscard]] std::string resolveProvider(const std::string& modId) const;
+
     bool disableMods(const std::vector<std::string>& modIds);
 
     bool enableMods(const std::vector<std::string>& modIds);
 
+    // Enables keepEnabled and everything it requires, disables the rest
     bool disableAllExcept(const std::unordered_set<std::string>& keepEnabled);
 
+    // Enables the given mods and what they need, disables every other one
+    bool setEnabledMods(const ModBitset& enabled);
+
+    // Closes `requested` over its dependencies, then drops whatever would need a mod outside
+    // `allowed`. Does not touch the files.
+    [[nodiscard]] EnablePlan planEnabledMods(const ModBitset& requested, const ModBitset& allowed) const;
+
+    // Reports the plan's pulled-in and pushed-out mods, then enables exactly plan.enabled
+    bool applyPlan(const EnablePlan& plan);
+
     bool enableAllMods();
 
+    // Switches between toggling by renaming JARs in place and a symlinked mods directory
+    // (see ModSetFarm), where each new mod set is swapped in with one atomic rename
+    bool setSymlinkFarm(bool enabled);
+
+    [[nodiscard]] bool usesSymlinkFarm() const { return modSetFarm.isActive(); }
+
     [[nodiscard]] std::unordered_set<std::string> getRequiredDependencies(
         const std::unordered_set<std::string>& modIds) const;
 
+    // The given mods plus the top-level mods they need
+    [[nodiscard]] ModBitset getRequiredDependencies(const ModBitset& handles) const {
+        return dependencyGraph.closureOf(handles);
+    }
+
+    // Rebuilt with the mod table whenever the mod list changes
+    [[nodiscard]] const DependencyGraph& getDependencyGraph() const { return dependencyGraph; }
+
+    // Enabled state is kept in memory: read on scan, updated by our own toggles and by watcher
+    // events. A mod whose file went missing counts as enabled.
+    [[nodiscard]] bool isEnabled(ModHandle handle) const { return !toggleState.disabled.test(handle); }
+
     [[nodiscard]] std::vector<std::string> getEnabledModIds() const;
 
+    [[nodiscard]] ModBitset getEnabledMods() const;
+
     [[nodiscard]] std::vector<std::string> getDisabledModIds() const;
 
     void printModList() const;
@@ -44,17 +130,87 @@ public:
 
 private:
     std::string modsDir;
+    ModSetFarm modSetFarm;
     std::vector<ModInfo> mods;
 
-    std::unordered_map<std::string, std::string> modIdToPath;
+    ModTable modTable;
+    DependencyGraph dependencyGraph;
+    uint64_t modListVersion = 0;
+    unsigned scanThreads = 0;
+
+    std::vector<ModInfo> providedMods;
+    std::unordered_map<std::string, size_t> providedModIndex;
+    std::unordered_map<std::string, std::vector<size_t>> nestedByContainer;
+    std::unordered_map<std::string_view, ModHandle> handleByJar;
+
+    mutable ClassIndex classIndex;
+    mutable bool classIndexBuilt = false;
+
+    struct JarScanResult {
+        enum class Outcome { NoModJson, ParseError, Loaded };
+
+        Outcome outcome = Outcome::NoModJson;
+        bool isDisabled = false;
+        std::string displayName;
+        std::string jarPath;
+        ModInfo mod;
+        std::vector<ModInfo> nestedMods;
+        std::optional<ModCacheEntry> cacheUpdate;
+    };
+
+    // JARs read per round of the batched scan; each round is a few io_uring submissions
+    static constexpr size_t SCAN_BATCH_SIZE = 256;
+
+    static JarScanResult scanJar(const fs::path& filePath, const ModCache& cache);
+
+    // scanJar for many JARs, with the reads of all changed JARs batched through JarArchive::openAll
+    void scanJarsBatched(const std::vector<fs::path>& jarFiles, const ModCache& cache,
+                         std::vector<JarScanResult>& results) const;
+
+    // Fills in the JAR's identity; true if the cached entry is still current
+    static bool lookupCache(const fs::path& filePath, const ModCache& cache,
+                            JarScanResult& result, ModCacheEntry& entry);
+
+    // Reuses the cached parse if fabric.mod.json's CRC is unchanged; true if it was parsed anew
+    static bool readModJson(const JarArchive& jar, const ModCacheEntry* cached, ModCacheEntry& entry);
+
+    // Nested JARs named by a freshly parsed fabric.mod.json
+    static std::vector<const JarEntry*> bundledEntries(const JarArchive& jar, const ModInfo& mod);
+
+    static void finishScan(JarScanResult& result, ModCacheEntry& entry);
+
+    static std::vector<ModInfo> scanNestedJars(const JarArchive& jar, const ModInfo& container);
+
+    static bool isModFile(const fs::path& filePath);
+
+    static std::string canonicalJarPath(const fs::path& filePath);
+
+    // Absolute and without a trailing separator, so JAR paths built from it compare equal
+    static std::string normalizeModsDirectory(const std::string& directory);
+
+    bool removeModsForJar(const std::string& jarPath);
+
+    // Which mods are there as x.jar and which as x.jar.disabled; a mod in neither set has no
+    // file at all
+    struct ToggleState {
+        ModBitset enabled;
+        ModBitset disabled;
+    };
+
+    ToggleState toggleState;
+
+    // One listing of the mods directory
+    [[nodiscard]] ToggleState readToggleState() const;
 
+    void setToggleState(ModHandle handle, bool enabled);
 
-    void collectDependencies(const std::string& modId,
-                            std::unordered_set<std::string>& result) const;
+    // Renames only the mods not already in the wanted state, as one journaled batch or, with
+    // the symlink farm, as one new mod set
+    bool applyToggles(const ModBitset& enable, const ModBitset& disable, bool reportUnchanged);
 
-    [[nodiscard]] std::string getDisabledPath(const std::string& jarPath) const;
+    void rebuildIndexes();
 
-    [[nodiscard]] bool isDisabled(const std::string& jarPath) const;
+    [[nodiscard]] std::string getDisabledPath(std::string_view jarPath) const;
 };
 
 #endif // FABRICBINARYSEARCH_MODMANAGER_H
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef FABRICBINARYSEARCH_MODWATCHER_H
+#define FABRICBINARYSEARCH_MODWATCHER_H
+
+#include "ModManager.h"
+#include <string>
+
+// Watches the mods directory (inotify, Linux only) and feeds add/remove/rename
+// events into ModManager so its mod table stays current without a full rescan.
+// Events are queued by the kernel and applied when poll() is called.
+class ModWatcher {
+public:
+    explicit ModWatcher(ModManager& manager);
+    ~ModWatcher();
+
+    ModWatcher(const ModWatcher&) = delete;
+    ModWatcher& operator=(const ModWatcher&) = delete;
+
+    [[nodiscard]] static bool isSupported();
+
+    bool start();
+
+    void stop();
+
+    [[nodiscard]] bool isActive() const { return inotifyFd >= 0; }
+
+    // Applies all pending events without blocking; returns the number of mod table changes
+    int poll();
+
+private:
+    ModManager& modManager;
+    std::string watchedDir;
+    int inotifyFd = -1;
+    int watchDescriptor = -1;
+
+    bool addWatch();
+};
+
+#endif // FABRICBINARYSEARCH_MODWATCHER_H
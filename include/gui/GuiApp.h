@@ -5,6 +5,7 @@
 
 #include "ModManager.h"
 #include "BinarySearchEngine.h"
+#include "ModWatcher.h"
 #include "CrashLogParser.h"
 #include <string>
 #include <memory>
@@ -26,11 +27,17 @@ private:
     GLFWwindow* window = nullptr;
     std::unique_ptr<ModManager> modManager;
     std::unique_ptr<BinarySearchEngine> searchEngine;
+    std::unique_ptr<ModWatcher> modWatcher;
 
     std::string modsPath;
     std::string instancePath;
     bool modsScanned = false;
     bool searchInProgress = false;
+    int searchStrategy = 0;
+    int parallelInstances = 4;
+    // Per pending test: 0 not set, 1 gone, 2 persists, 3 unsure
+    std::vector<int> parallelResults;
+    bool watchModsFolder = false;
     std::string statusMessage;
     std::string crashLogContent;
     std::optional<CrashInfo> lastCrashInfo;
@@ -43,6 +50,7 @@ private:
     bool showModMetadata = false;
     bool showSettings = false;
     std::string selectedModId;
+    ModMetadata selectedModMetadata;
 
     bool isScanning = false;
     bool isAnalyzing = false;
@@ -60,9 +68,11 @@ private:
     void renderStatusBar() const;
 
     void scanMods();
+    void updateModWatcher();
     void startBinarySearch();
     void reportSuccess();
     void reportFailure();
+    void reportParallelResults();
     void analyzeCrashLog();
     void analyzeCrashLog(const std::string& logPath);
     void refreshLogLists();
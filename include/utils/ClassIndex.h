@@ -0,0 +1,62 @@
+#ifndef FABRICBINARYSEARCH_CLASSINDEX_H
+#define FABRICBINARYSEARCH_CLASSINDEX_H
+
+#include "JarReader.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <cstdint>
+
+// Maps every .class file found in the scanned JARs to the mod that ships it.
+// Class names live in one string arena; lookups are binary searches over a
+// table of (offset, length, owner) records sorted by name.
+class ClassIndex {
+public:
+    // Classes of a single JAR (including its nested JARs), before merging
+    struct JarClasses {
+        std::string owner;
+        std::vector<std::string> classNames;
+    };
+
+    static JarClasses collectClasses(const JarArchive& jar, const std::string& owner);
+
+    void build(std::vector<JarClasses> jars);
+
+    void clear();
+
+    [[nodiscard]] bool empty() const { return records.empty(); }
+
+    [[nodiscard]] size_t size() const { return records.size(); }
+
+    // Owner of a class given as "a.b.C", "a/b/C" or with inner-class suffixes ("a.b.C$1")
+    [[nodiscard]] std::optional<std::string> findOwner(std::string_view className) const;
+
+    // Owner of the deepest package of className that holds indexed classes, for classes the
+    // index can't know (e.g. generated at runtime); none if several mods share that package
+    [[nodiscard]] std::optional<std::string> findPackageOwner(std::string_view className) const;
+
+private:
+    struct Record {
+        uint32_t offset;
+        uint32_t length;
+        uint32_t owner;
+    };
+
+    // Two levels ("net/fabricmc/") are still shared between unrelated projects
+    static constexpr size_t MIN_PACKAGE_DEPTH = 3;
+
+    std::string arena;
+    std::vector<Record> records;
+    std::vector<std::string> owners;
+
+    [[nodiscard]] std::string_view nameOf(const Record& record) const {
+        return std::string_view(arena).substr(record.offset, record.length);
+    }
+
+    static std::string normalize(std::string_view className);
+
+    static void collectFrom(const JarArchive& jar, std::vector<std::string>& classNames, int depth);
+};
+
+#endif // FABRICBINARYSEARCH_CLASSINDEX_H
@@ -0,0 +1,35 @@
+#ifndef FABRICBINARYSEARCH_COMPRESSEDTEXT_H
+#define FABRICBINARYSEARCH_COMPRESSEDTEXT_H
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <cstdint>
+
+// Text held as a raw deflate stream until it is needed. A deflated JAR entry is already in
+// this form, so it can be adopted as is.
+class CompressedText {
+public:
+    CompressedText() = default;
+
+    static CompressedText compress(std::string_view text);
+
+    // Takes over a raw deflate stream, e.g. the payload of a deflated ZIP entry
+    static CompressedText fromDeflated(std::string_view deflated, uint32_t originalSize);
+
+    [[nodiscard]] std::string decompress() const;
+
+    [[nodiscard]] bool empty() const { return originalSize == 0; }
+    [[nodiscard]] size_t size() const { return originalSize; }
+    [[nodiscard]] size_t compressedSize() const { return deflated.size(); }
+
+    // Text form for the JSON scan cache
+    [[nodiscard]] std::string toBase64() const;
+    static std::optional<CompressedText> fromBase64(std::string_view encoded, uint32_t originalSize);
+
+private:
+    std::string deflated;
+    uint32_t originalSize = 0;
+};
+
+#endif // FABRICBINARYSEARCH_COMPRESSEDTEXT_H
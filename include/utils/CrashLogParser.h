@@ -5,6 +5,8 @@
 #include <vector>
 #include <optional>
 
+class ClassIndex;
+
 struct CrashInfo {
     std::string crashType;
     std::vector<std::string> suspectedMods;
@@ -17,9 +19,12 @@ struct CrashInfo {
 
 class CrashLogParser {
 public:
-    static std::optional<CrashInfo> parseCrashLog(const std::string& logPath);
+    // With a class index, stack frames are attributed to the mod that ships the frame's class
+    static std::optional<CrashInfo> parseCrashLog(const std::string& logPath,
+                                                  const ClassIndex* classIndex = nullptr);
 
-    static std::optional<CrashInfo> parseCrashLogContent(const std::string& content);
+    static std::optional<CrashInfo> parseCrashLogContent(const std::string& content,
+                                                         const ClassIndex* classIndex = nullptr);
 
     static std::optional<std::string> findLatestCrashLog(const std::string& crashReportsDir);
 
@@ -28,7 +33,10 @@ public:
     static std::vector<std::string> listGameLogs(const std::string& logsDir);
 
 private:
-    static std::optional<std::string> extractModIdFromStackTrace(const std::string& line);
+    static std::optional<std::string> extractModIdFromStackTrace(const std::string& line,
+                                                                 const ClassIndex* classIndex);
+
+    static std::optional<std::string> extractFrameClass(const std::string& line);
 
     static bool isMixinCrash(const std::string& content);
 
@@ -0,0 +1,59 @@
+#ifndef FABRICBINARYSEARCH_DEPENDENCYGRAPH_H
+#define FABRICBINARYSEARCH_DEPENDENCYGRAPH_H
+
+#include "ModTable.h"
+#include "ModBitset.h"
+#include <vector>
+#include <span>
+#include <cstdint>
+
+// JAR-level "needs" graph over mod handles in compressed sparse row form, with the reverse
+// edges alongside. An edge a -> b means a's JAR cannot load without b's. Dependency cycles
+// are collapsed into strongly connected components, and each component stores its full
+// transitive closure as a bitset, so the closure of any set of mods is one OR per member.
+class DependencyGraph {
+public:
+    void build(const ModTable& table);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const { return component.size(); }
+
+    // Direct dependencies of a mod, sorted by handle
+    [[nodiscard]] std::span<const ModHandle> dependencies(ModHandle handle) const {
+        return std::span(targets).subspan(start[handle], start[handle + 1] - start[handle]);
+    }
+
+    // Mods that directly need this one, sorted by handle
+    [[nodiscard]] std::span<const ModHandle> dependents(ModHandle handle) const {
+        return std::span(reverseTargets).subspan(reverseStart[handle], reverseStart[handle + 1] - reverseStart[handle]);
+    }
+
+    [[nodiscard]] size_t componentCount() const { return componentClosures.size(); }
+
+    // Components are numbered dependencies-first: a component only needs lower-numbered ones
+    [[nodiscard]] uint32_t componentOf(ModHandle handle) const { return component[handle]; }
+
+    [[nodiscard]] const ModBitset& componentClosure(uint32_t componentIndex) const {
+        return componentClosures[componentIndex];
+    }
+
+    // roots plus everything they transitively need
+    [[nodiscard]] ModBitset closureOf(const ModBitset& roots) const;
+
+    // roots plus everything that transitively needs one of them
+    [[nodiscard]] ModBitset dependentClosureOf(const ModBitset& roots) const;
+
+private:
+    std::vector<uint32_t> start;
+    std::vector<ModHandle> targets;
+    std::vector<uint32_t> reverseStart;
+    std::vector<ModHandle> reverseTargets;
+
+    std::vector<uint32_t> component;
+    std::vector<ModBitset> componentClosures;
+
+    void findComponents();
+};
+
+#endif // FABRICBINARYSEARCH_DEPENDENCYGRAPH_H
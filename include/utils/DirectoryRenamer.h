@@ -0,0 +1,50 @@
+#ifndef FABRICBINARYSEARCH_DIRECTORYRENAMER_H
+#define FABRICBINARYSEARCH_DIRECTORYRENAMER_H
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Renames files inside one directory relative to a handle opened once, so the kernel (or an
+// NFS server) does not resolve the whole path for every file. A rename never replaces an
+// existing file: renameat2(RENAME_NOREPLACE) on Linux, or a check before renameat where the
+// filesystem does not take that flag. Independent renames run on a small thread pool.
+class DirectoryRenamer {
+public:
+    // File names inside the directory, with the outcome filled in by renameAll
+    struct Rename {
+        std::string from;
+        std::string to;
+        std::error_code error;
+    };
+
+    // Renames mostly wait on metadata round trips, so a few more threads than cores still help
+    static constexpr unsigned DEFAULT_THREADS = 8;
+
+    explicit DirectoryRenamer(const fs::path& directory);
+    ~DirectoryRenamer();
+
+    DirectoryRenamer(const DirectoryRenamer&) = delete;
+    DirectoryRenamer& operator=(const DirectoryRenamer&) = delete;
+
+    [[nodiscard]] bool isOpen() const;
+
+    // Runs every rename and records each result; true if all of them succeeded. Failed
+    // entries can be passed back in to retry them.
+    bool renameAll(std::vector<Rename>& renames, unsigned threads = DEFAULT_THREADS);
+
+private:
+    fs::path directory;
+    int dirFd = -1;
+
+    // Set once the filesystem rejects RENAME_NOREPLACE, so later renames skip straight to the check
+    std::atomic<bool> noReplaceUnsupported{false};
+
+    std::error_code renameOne(const std::string& from, const std::string& to);
+};
+
+#endif // FABRICBINARYSEARCH_DIRECTORYRENAMER_H
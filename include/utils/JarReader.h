@@ -2,17 +2,122 @@
 #define FABRICBINARYSEARCH_JARREADER_H
 
 #include <string>
+#include <cstdint>
 #include <optional>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+class MappedFile;
+class SparseFile;
+class Inflater;
+
+// One central directory record. The name points into the archive's bytes and
+// stays valid for as long as the owning JarArchive.
+struct JarEntry {
+    std::string_view name;
+    uint32_t crc32 = 0;
+    uint32_t compressedSize = 0;
+    uint32_t uncompressedSize = 0;
+    uint32_t localHeaderOffset = 0;
+    uint16_t compressionMethod = 0;
+};
+
+// A ZIP/JAR whose central directory has been parsed once into an index.
+// Any number of entries can then be looked up and inflated without rescanning,
+// sharing a single inflate context.
+class JarArchive {
+public:
+    static std::optional<JarArchive> open(const std::string& jarPath);
+
+    // Archive held in memory by the caller (e.g. a stored nested JAR); data must outlive the archive
+    static std::optional<JarArchive> fromMemory(std::string_view data);
+
+    // Archive that takes ownership of its bytes (e.g. an inflated nested JAR)
+    static std::optional<JarArchive> fromBuffer(std::string data);
+
+    // Opens many archives at once. With io_uring the tails of all files are read in one batch
+    // and the central directories that didn't fit in them in a second; entry data is fetched
+    // later through prefetch(). Without io_uring this is open() on each path.
+    static std::vector<std::optional<JarArchive>> openAll(const std::vector<std::string>& jarPaths);
+
+    // Reads the given entries of archives from openAll() in one batch, so that later read() and
+    // rawData() calls on them are served from memory. Mapped archives are skipped.
+    static void prefetch(const std::vector<std::pair<JarArchive*, const JarEntry*>>& entries);
+
+    JarArchive(JarArchive&&) noexcept;
+    JarArchive& operator=(JarArchive&&) noexcept;
+    ~JarArchive();
+
+    [[nodiscard]] const std::vector<JarEntry>& entries() const { return entryList; }
+
+    [[nodiscard]] const JarEntry* find(std::string_view name) const;
+
+    // Entries whose names match a glob; '*' stops at '/', '**' and '?' behave as usual
+    [[nodiscard]] std::vector<const JarEntry*> findMatching(std::string_view pattern) const;
+
+    [[nodiscard]] std::optional<std::string> read(const JarEntry& entry) const;
+
+    [[nodiscard]] std::optional<std::string> read(std::string_view name) const;
+
+    // Reads every entry named exactly in `names` or matching one of `patterns`, keyed by entry name
+    [[nodiscard]] std::unordered_map<std::string, std::string> extract(
+        const std::vector<std::string>& names,
+        const std::vector<std::string>& patterns = {}) const;
+
+    // Compressed bytes of an entry as stored in the archive
+    [[nodiscard]] std::optional<std::string_view> rawData(const JarEntry& entry) const;
+
+private:
+    JarArchive();
+
+    std::unique_ptr<MappedFile> mapping;
+    std::unique_ptr<std::string> ownedData;
+    std::string_view data;
+
+    // Set instead of `data` for archives read in pieces by openAll()
+    std::unique_ptr<SparseFile> sparse;
+
+    std::vector<JarEntry> entryList;
+    std::unordered_map<std::string_view, size_t> index;
+    std::unique_ptr<Inflater> inflater;
+
+    bool parseCentralDirectory();
+
+    bool indexCentralDirectory(std::string_view directory, uint16_t numEntries);
+
+    [[nodiscard]] std::optional<std::string_view> span(uint64_t offset, size_t length) const;
+};
 
 class JarReader {
 public:
-    static std::optional<std::string> extractFabricModJson(const std::string& jarPath);
+    // entryCrc, if given, receives the CRC32 recorded for fabric.mod.json in the central directory
+    static std::optional<std::string> extractFabricModJson(const std::string& jarPath,
+                                                           uint32_t* entryCrc = nullptr);
 
     static bool isValidJar(const std::string& jarPath);
 
+    // Called with each nested JAR's entry path and fabric.mod.json; returns the nested
+    // JAR's own `jars` entries so the walk can descend into them
+    using NestedJarVisitor = std::function<std::vector<std::string>(const std::string& entryPath,
+                                                                    const std::string& modJson)>;
+
+    // Walks jar-in-jar entries (META-INF/jars/...) entirely in memory
+    static void visitNestedJars(const JarArchive& jar, const std::vector<std::string>& entries,
+                                const NestedJarVisitor& visitor);
+
+    // CRC32 recorded in the central directory for an entry, without inflating it
+    static std::optional<uint32_t> getEntryCrc32(const std::string& zipPath, std::string_view filename);
+
+    static bool matchesGlob(std::string_view pattern, std::string_view name);
+
 private:
-    static std::optional<std::string> readFileFromZip(const std::string& zipPath,
-                                                      const std::string& filename);
+    static constexpr int MAX_NESTING_DEPTH = 8;
+
+    static void visitNestedJars(const JarArchive& jar, const std::vector<std::string>& entries,
+                                const NestedJarVisitor& visitor, int depth);
 };
 
-#endif // FABRICBINARYSEARCH_JARREADER_H
\ No newline at end of file
+#endif // FABRICBINARYSEARCH_JARREADER_H
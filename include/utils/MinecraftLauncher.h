@@ -16,8 +16,16 @@ public:
 
     [[nodiscard]] bool canLaunch() const;
 
+    // Runs the game in another directory (own mods/, logs and saves) with this instance's files
+    void setGameDirectory(const fs::path& directory) { gameDirectory = directory; }
+
+    // False if a custom launch command is set without a {gameDir} placeholder, as it would
+    // always start the instance itself
+    [[nodiscard]] bool canLaunchGameDirectory() const;
+
 private:
     fs::path instancePath;
+    fs::path gameDirectory;
     fs::path modsPath;
     fs::path versionsPath;
     fs::path librariesPath;
@@ -0,0 +1,72 @@
+#ifndef FABRICBINARYSEARCH_MODBITSET_H
+#define FABRICBINARYSEARCH_MODBITSET_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <bit>
+
+// Dense index of a top-level mod: its position in ModManager::getMods() after the last scan
+using ModHandle = uint32_t;
+
+// Set of mod handles, one bit per mod. Set operations work a 64-bit word at a time;
+// both operands of a binary operation must have the same size.
+class ModBitset {
+public:
+    ModBitset() = default;
+
+    explicit ModBitset(size_t size, bool value = false);
+
+    [[nodiscard]] size_t size() const { return bitCount; }
+
+    [[nodiscard]] bool test(ModHandle handle) const {
+        return words[handle / WORD_BITS] >> (handle % WORD_BITS) & 1;
+    }
+
+    void set(ModHandle handle) { words[handle / WORD_BITS] |= uint64_t{1} << (handle % WORD_BITS); }
+
+    void reset(ModHandle handle) { words[handle / WORD_BITS] &= ~(uint64_t{1} << (handle % WORD_BITS)); }
+
+    // Number of handles in the set
+    [[nodiscard]] size_t count() const;
+
+    [[nodiscard]] bool none() const;
+
+    [[nodiscard]] bool any() const { return !none(); }
+
+    // The lowest `n` handles of the set (all of them if it has fewer)
+    [[nodiscard]] ModBitset lowest(size_t n) const;
+
+    ModBitset& operator|=(const ModBitset& other);
+
+    ModBitset& operator&=(const ModBitset& other);
+
+    // Set difference
+    ModBitset& operator-=(const ModBitset& other);
+
+    friend ModBitset operator|(ModBitset lhs, const ModBitset& rhs) { return lhs |= rhs; }
+
+    friend ModBitset operator&(ModBitset lhs, const ModBitset& rhs) { return lhs &= rhs; }
+
+    friend ModBitset operator-(ModBitset lhs, const ModBitset& rhs) { return lhs -= rhs; }
+
+    bool operator==(const ModBitset& other) const = default;
+
+    // Calls fn(handle) for every handle in the set, in increasing order
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+                fn(static_cast<ModHandle>(w * WORD_BITS + std::countr_zero(word)));
+            }
+        }
+    }
+
+private:
+    static constexpr size_t WORD_BITS = 64;
+
+    std::vector<uint64_t> words;
+    size_t bitCount = 0;
+};
+
+#endif // FABRICBINARYSEARCH_MODBITSET_H
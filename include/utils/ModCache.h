@@ -0,0 +1,69 @@
+#ifndef FABRICBINARYSEARCH_MODCACHE_H
+#define FABRICBINARYSEARCH_MODCACHE_H
+
+#include "ModInfo.h"
+#include <string>
+#include <optional>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+struct ModCacheEntry {
+    uintmax_t fileSize = 0;
+    int64_t modifiedTime = 0;
+
+    // CRC32 of fabric.mod.json from the central directory; empty if the JAR has none
+    std::optional<uint32_t> modJsonCrc;
+    bool parsed = false;
+    ModInfo mod;
+    std::vector<ModInfo> nestedMods;
+
+    json toJson() const;
+    static ModCacheEntry fromJson(const json& j);
+};
+
+// Parsed fabric.mod.json results per JAR, persisted next to config.json so
+// rescans only have to touch JARs that changed since the last scan.
+class ModCache {
+public:
+    static ModCache& getInstance();
+
+    bool load();
+    bool save();
+    bool clear();
+
+    // Entries are keyed by the enabled JAR path, so toggling a mod keeps its entry
+    [[nodiscard]] const ModCacheEntry* find(const std::string& jarPath) const;
+    void store(const std::string& jarPath, const ModCacheEntry& entry);
+
+    // Drops entries for JARs in modsDir that were not seen by the last scan
+    void prune(const std::string& modsDir, const std::unordered_set<std::string>& presentJars);
+
+    std::string getCachePath() const;
+
+    // Points the cache at another file (e.g. a benchmark's scratch directory); nothing is carried over
+    void setCachePath(const fs::path& path);
+
+    ModCache(const ModCache&) = delete;
+    ModCache& operator=(const ModCache&) = delete;
+
+private:
+    ModCache();
+
+    static constexpr int FORMAT_VERSION = 6;
+
+    fs::path cacheFilePath;
+    std::unordered_map<std::string, ModCacheEntry> entries;
+    bool loaded = false;
+    bool dirty = false;
+
+    fs::path getDefaultCachePath() const;
+};
+
+#endif // FABRICBINARYSEARCH_MODCACHE_H
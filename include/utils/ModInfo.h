@@ -5,34 +5,66 @@
 #include <vector>
 #include <unordered_map>
 #include <nlohmann/json.hpp>
+#include "CompressedText.h"
 
 using json = nlohmann::json;
 
+// The parts of fabric.mod.json only the metadata view needs, built on demand by ModInfo::loadMetadata
+struct ModMetadata {
+    std::string description;
+    std::vector<std::string> authors;
+
+    std::string homepage;
+    std::string sources;
+    std::string issues;
+    std::unordered_map<std::string, std::string> contact;
+
+    // fabric.mod.json re-indented for display
+    std::string rawJson;
+};
+
 class ModInfo {
 public:
     std::string id;
     std::string name;
     std::string version;
-    std::string description;
     std::string jarPath;
 
     std::unordered_map<std::string, std::string> depends;
     std::unordered_map<std::string, std::string> suggests;
 
-    std::vector<std::string> authors;
+    // Alias IDs this mod also answers to as a dependency (e.g. "cloth_config")
+    std::vector<std::string> provides;
+
     std::string environment;
 
-    // Contact/Links metadata
-    std::string homepage;
-    std::string sources;
-    std::string issues;
-    std::unordered_map<std::string, std::string> contact;
+    // Jar-in-jar entries declared under "jars" (e.g. META-INF/jars/foo.jar)
+    std::vector<std::string> jars;
 
-    // Store raw fabric.mod.json for full metadata display
-    std::string rawJson;
+    // Mixin config files, access widener and icon paths inside the JAR
+    std::vector<std::string> mixins;
+    std::string accessWidener;
+    std::string icon;
+
+    // For mods nested inside another JAR: ID of the top-level mod whose JAR provides it
+    std::string providedBy;
+
+    // fabric.mod.json as found in the JAR, compressed until loadMetadata() needs it
+    CompressedText source;
 
     bool parseFromJson(const std::string& jsonContent);
 
+    // Same, but keeps an already deflated copy of jsonContent (e.g. the JAR entry's own payload)
+    // instead of compressing it again
+    bool parseFromJson(const std::string& jsonContent, CompressedText compressedSource);
+
+    // Description, authors, links and the formatted document; decompressed and parsed on each call
+    [[nodiscard]] ModMetadata loadMetadata() const;
+
+    // Round-trip of the parsed fields, used by the scan cache
+    [[nodiscard]] json toJson() const;
+    static ModInfo fromJson(const json& j);
+
     [[nodiscard]] bool dependsOn(const std::string& modId) const;
 
     [[nodiscard]] std::vector<std::string> getDependencies() const;
@@ -40,8 +72,7 @@ public:
     void print() const;
 
 private:
-    static void parseDependencies(const json& j, const std::string& key,
-                                  std::unordered_map<std::string, std::string>& target);
+    bool parseFields(const std::string& jsonContent);
 };
 
 #endif // FABRICBINARYSEARCH_MODINFO_H
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef FABRICBINARYSEARCH_MODSETFARM_H
+#define FABRICBINARYSEARCH_MODSETFARM_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Toggle backend that never renames inside the mods directory. Every JAR is kept once in a
+// store next to it, and mods/ is a symlink to a "set" directory holding one link per JAR,
+// named x.jar or x.jar.disabled. A new set is built off to the side and mods/ is repointed
+// with a single rename, so the game or a launcher watching mods/ only ever sees a complete
+// mod set. Needs a filesystem and OS that allow symlinks (on Windows, Developer Mode).
+//
+// Layout, for <instance>/mods:
+//   <instance>/.fabric-binary-search/store/   the JARs
+//   <instance>/.fabric-binary-search/sets/N/  links into the store; mods -> here
+class ModSetFarm {
+public:
+    explicit ModSetFarm(const fs::path& modsDirectory);
+
+    // True if mods/ is a symlink into this farm's sets
+    [[nodiscard]] bool isActive() const;
+
+    // Moves a plain mods directory into the store and links it back as the first set
+    bool convert();
+
+    // Turns mods/ back into a plain directory with the files of the current set
+    bool revert();
+
+    // Builds a set like the current one, with the named files (x.jar, never x.jar.disabled)
+    // enabled or disabled as given, and switches mods/ to it. Files dropped straight into
+    // mods/ since the last switch are moved into the store first.
+    bool switchTo(const std::unordered_map<std::string, bool>& enabledByName);
+
+    // Finishes a conversion or reversion that was cut short
+    void recover();
+
+    [[nodiscard]] const fs::path& getRoot() const { return root; }
+
+private:
+    struct Entry {
+        std::string storeName;
+        std::string name;
+        bool enabled;
+    };
+
+    fs::path modsDir;
+    fs::path root;
+    fs::path storeDir;
+    fs::path setsDir;
+
+    // The live set, adopting any file in it that is not a link into the store
+    bool readLiveSet(std::vector<Entry>& entries) const;
+
+    // Store contents as they were in a plain mods directory
+    bool readStore(std::vector<Entry>& entries) const;
+
+    // Builds a new set from entries and points mods/ at it
+    bool activate(const std::vector<Entry>& entries);
+
+    bool repoint(const fs::path& setDir) const;
+
+    // Whether a directory symlink can be created next to mods/, as every switch needs one
+    [[nodiscard]] bool canSymlink() const;
+
+    // Moves the current set's files into a plain directory that then replaces mods/
+    bool finishRevert();
+
+    [[nodiscard]] fs::path currentSet() const;
+
+    [[nodiscard]] fs::path nextSetPath() const;
+};
+
+#endif // FABRICBINARYSEARCH_MODSETFARM_H
@@ -0,0 +1,85 @@
+#ifndef FABRICBINARYSEARCH_MODTABLE_H
+#define FABRICBINARYSEARCH_MODTABLE_H
+
+#include "ModInfo.h"
+#include "ModBitset.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <optional>
+#include <unordered_map>
+#include <cstdint>
+
+// Compact, read-only copy of the scanned top-level mods for the hot paths, one column per
+// field. Every mod ID that appears anywhere (as a mod, a nested mod, a `provides` alias or a
+// dependency) is interned once as a Symbol; all strings live in a single arena.
+class ModTable {
+public:
+    using Symbol = uint32_t;
+
+    // mods[i] gets handle i; providedMods are the jar-in-jar mods, each naming its container
+    void build(const std::vector<ModInfo>& mods, const std::vector<ModInfo>& providedMods);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const { return modSymbols.size(); }
+
+    [[nodiscard]] std::string_view id(ModHandle handle) const { return name(modSymbols[handle]); }
+
+    [[nodiscard]] std::string_view version(ModHandle handle) const { return view(versions[handle]); }
+
+    [[nodiscard]] std::string_view jarPath(ModHandle handle) const { return view(jarPaths[handle]); }
+
+    [[nodiscard]] Symbol symbol(ModHandle handle) const { return modSymbols[handle]; }
+
+    // Mod IDs the JAR needs to load: its own depends and those of the mods bundled in it,
+    // minus what it bundles itself. Sorted by symbol, no duplicates.
+    [[nodiscard]] std::span<const Symbol> dependencies(ModHandle handle) const {
+        return std::span(dependencySymbols).subspan(dependencyStart[handle],
+                                                    dependencyStart[handle + 1] - dependencyStart[handle]);
+    }
+
+    [[nodiscard]] size_t symbolCount() const { return symbolNames.size(); }
+
+    [[nodiscard]] std::string_view name(Symbol symbol) const { return view(symbolNames[symbol]); }
+
+    [[nodiscard]] std::optional<Symbol> findSymbol(std::string_view modId) const;
+
+    // Top-level mods only
+    [[nodiscard]] std::optional<ModHandle> findHandle(std::string_view modId) const;
+
+    // The top-level mod whose JAR supplies the symbol: the mod itself, the JAR bundling it, or
+    // the JAR of a mod that provides it as an alias. Real IDs win over aliases.
+    [[nodiscard]] std::optional<ModHandle> providerOf(Symbol symbol) const;
+
+private:
+    struct StringRef {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    static constexpr ModHandle NO_PROVIDER = UINT32_MAX;
+
+    std::string arena;
+    std::vector<StringRef> symbolNames;
+    std::unordered_map<std::string_view, Symbol> symbolIndex;
+    std::vector<ModHandle> providers;
+
+    std::vector<Symbol> modSymbols;
+    std::vector<StringRef> versions;
+    std::vector<StringRef> jarPaths;
+
+    std::vector<uint32_t> dependencyStart;
+    std::vector<Symbol> dependencySymbols;
+
+    [[nodiscard]] std::string_view view(StringRef ref) const {
+        return std::string_view(arena).substr(ref.offset, ref.length);
+    }
+
+    StringRef store(std::string_view text);
+
+    Symbol intern(std::string_view modId);
+};
+
+#endif // FABRICBINARYSEARCH_MODTABLE_H
@@ -0,0 +1,46 @@
+#ifndef FABRICBINARYSEARCH_PARALLELFOR_H
+#define FABRICBINARYSEARCH_PARALLELFOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Runs fn(i) for every i in [0, count) on up to `threads` workers (0 = one per core).
+// Work is handed out one index at a time, so callers write results into
+// pre-sized slots and keep their output order independent of scheduling.
+template <typename Fn>
+void parallelFor(size_t count, unsigned threads, Fn&& fn) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const size_t workerCount = std::min<size_t>(threads, count);
+    if (workerCount <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workerCount - 1);
+    for (size_t t = 1; t < workerCount; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+#endif // FABRICBINARYSEARCH_PARALLELFOR_H
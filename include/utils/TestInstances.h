@@ -0,0 +1,35 @@
+#ifndef FABRICBINARYSEARCH_TESTINSTANCES_H
+#define FABRICBINARYSEARCH_TESTINSTANCES_H
+
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Scratch game directories for testing several mod sets at once. Each slot is a game
+// directory of its own, so logs, crash reports and worlds stay apart, with a mods/ that
+// links to the JARs enabled for its test and a config/ that links to the instance's.
+// The instance's own mods directory is never touched.
+//
+// Layout, for <instance>/mods:
+//   <instance>/.fabric-binary-search/instances/N/   game directory of slot N
+class TestInstances {
+public:
+    explicit TestInstances(const fs::path& modsDirectory);
+
+    // Makes slot's mods/ hold exactly the given JARs (symlinked, or hard linked where
+    // the OS does not allow symlinks)
+    bool prepare(size_t slot, const std::vector<fs::path>& jars);
+
+    // To launch the game with as --gameDir
+    [[nodiscard]] fs::path gameDirectory(size_t slot) const;
+
+    // Removes every slot
+    void clear();
+
+private:
+    fs::path instanceDir;
+    fs::path root;
+};
+
+#endif // FABRICBINARYSEARCH_TESTINSTANCES_H
@@ -0,0 +1,53 @@
+#ifndef FABRICBINARYSEARCH_TOGGLEJOURNAL_H
+#define FABRICBINARYSEARCH_TOGGLEJOURNAL_H
+
+#include <string>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Write-ahead log for the renames that enable and disable mods. A batch is appended and
+// synced to disk before its first rename and marked done after its last, so a batch cut
+// short by a crash is finished by recover() on the next start.
+class ToggleJournal {
+public:
+    struct Rename {
+        std::string from;
+        std::string to;
+    };
+
+    static ToggleJournal& getInstance();
+
+    // Records a batch as about to be applied; false if it could not be made durable
+    bool begin(const std::vector<Rename>& renames);
+
+    // Marks the batch from the last begin() as fully applied
+    void commit();
+
+    // Finishes a batch an earlier run left unfinished and returns how many renames it redid.
+    // A batch that was never fully recorded had not started renaming and is dropped.
+    size_t recover();
+
+    std::string getJournalPath() const;
+
+    // Points the journal at another file (e.g. a benchmark's scratch directory)
+    void setJournalPath(const fs::path& path);
+
+    ToggleJournal(const ToggleJournal&) = delete;
+    ToggleJournal& operator=(const ToggleJournal&) = delete;
+
+private:
+    ToggleJournal();
+
+    // Finished batches are dropped once the file grows past this
+    static constexpr uintmax_t COMPACT_THRESHOLD = 256 * 1024;
+
+    fs::path journalFilePath;
+
+    bool append(const std::string& text) const;
+
+    fs::path getDefaultJournalPath() const;
+};
+
+#endif // FABRICBINARYSEARCH_TOGGLEJOURNAL_H
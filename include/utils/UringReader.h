@@ -0,0 +1,64 @@
+#ifndef FABRICBINARYSEARCH_URINGREADER_H
+#define FABRICBINARYSEARCH_URINGREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One positional read into a caller-owned buffer
+struct ReadRequest {
+    int fd = -1;
+    uint64_t offset = 0;
+    char* buffer = nullptr;
+    uint32_t length = 0;
+
+    // Bytes read, or -errno on failure
+    int64_t result = 0;
+};
+
+// Batched reads through Linux io_uring. A whole batch is queued at once, so the kernel
+// sees one deep queue instead of a synchronous round trip per read.
+class UringReader {
+public:
+    static constexpr unsigned DEFAULT_QUEUE_DEPTH = 256;
+
+    // Whether this kernel lets us create a ring (checked once per process)
+    static bool isSupported();
+
+    explicit UringReader(unsigned queueDepth = DEFAULT_QUEUE_DEPTH);
+    ~UringReader();
+
+    UringReader(const UringReader&) = delete;
+    UringReader& operator=(const UringReader&) = delete;
+
+    [[nodiscard]] bool isOpen() const { return ringFd >= 0; }
+
+    // Runs every request to completion. Short or failed ring reads are finished with pread,
+    // so this only returns false if a request could not be read at all.
+    bool readAll(std::vector<ReadRequest>& requests);
+
+private:
+    int ringFd = -1;
+
+    void* ringMemory = nullptr;
+    size_t ringSize = 0;
+    void* sqeMemory = nullptr;
+    size_t sqeSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqEntries = 0;
+
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    void* cqes = nullptr;
+
+    bool submitAndReap(std::vector<ReadRequest>& requests);
+
+    static bool finishWithPread(ReadRequest& request, size_t alreadyRead);
+};
+
+#endif // FABRICBINARYSEARCH_URINGREADER_H
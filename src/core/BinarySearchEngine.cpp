@@ -1,29 +1,56 @@
 #include "BinarySearchEngine.h"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 
 BinarySearchEngine::BinarySearchEngine(ModManager& manager)
     : modManager(manager), state(SearchState::NOT_STARTED), iteration(0) {}
 
 void BinarySearchEngine::startSearch() {
-    std::cout << "\n=== Starting Binary Search ===" << std::endl;
+    if (strategy == SearchStrategy::DELTA_DEBUG) {
+        std::cout << "\n=== Starting Delta Debugging ===" << std::endl;
+    } else if (strategy == SearchStrategy::ALL_CULPRITS) {
+        std::cout << "\n=== Starting Search For All Culprits ===" << std::endl;
+    } else if (strategy == SearchStrategy::LIKELY_FIRST) {
+        std::cout << "\n=== Starting Crash-Log-Guided Binary Search ===" << std::endl;
+    } else if (strategy == SearchStrategy::PARALLEL) {
+        std::cout << "\n=== Starting Parallel Search (" << parallelism << " instances per round) ===" << std::endl;
+    } else {
+        std::cout << "\n=== Starting Binary Search ===" << std::endl;
+    }
 
-    allMods = modManager.getEnabledModIds();
+    allMods = modManager.getEnabledMods();
     suspects = allMods;
+    modListVersion = modManager.getModListVersion();
 
-    if (suspects.size() < 2) {
+    if (suspects.count() < 2) {
         std::cout << "Not enough mods to perform binary search (need at least 2)" << std::endl;
         state = SearchState::FAILED;
         return;
     }
 
-    std::cout << "Starting with " << suspects.size() << " mods" << std::endl;
+    std::cout << "Starting with " << suspects.count() << " mods" << std::endl;
 
     iteration = 0;
-    innocent.clear();
-    currentlyDisabled.clear();
+    innocent = ModBitset(allMods.size());
+    currentlyEnabled = allMods;
+    pendingConfigs.clear();
     state = SearchState::IN_PROGRESS;
 
+    if (strategy == SearchStrategy::DELTA_DEBUG) {
+        deltaDebugger.start(suspects, [this](const ModBitset& requested) {
+            return modManager.planEnabledMods(requested, allMods).enabled;
+        });
+    } else if (strategy == SearchStrategy::ALL_CULPRITS) {
+        groupTester.start(suspects, [this](const ModBitset& requested, const ModBitset& culprits) {
+            return modManager.planEnabledMods(requested, allMods - culprits).enabled;
+        });
+    } else if (strategy == SearchStrategy::LIKELY_FIRST) {
+        computePriors();
+    } else if (strategy == SearchStrategy::PARALLEL) {
+        testInstances.emplace(modManager.getModsDirectory());
+    }
+
     nextIteration();
 }
 
@@ -33,37 +60,216 @@ bool BinarySearchEngine::nextIteration() {
         return false;
     }
 
-    if (suspects.size() == 1) {
+    if (!checkModList()) return false;
+
+    if (strategy == SearchStrategy::DELTA_DEBUG) return nextDeltaDebugIteration();
+    if (strategy == SearchStrategy::ALL_CULPRITS) return nextGroupTestIteration();
+
+    if (suspects.count() == 1) {
         std::cout << "\n=== Found the culprit! ===" << std::endl;
-        std::cout << "Problematic mod: " << suspects[0] << std::endl;
+        std::cout << "Problematic mod: " << idsOf(suspects)[0] << std::endl;
         state = SearchState::COMPLETED;
         return false;
     }
 
+    if (strategy == SearchStrategy::PARALLEL) return nextParallelIteration();
+
     iteration++;
     std::cout << "\n=== Iteration " << iteration << " ===" << std::endl;
-    std::cout << "Suspects remaining: " << suspects.size() << std::endl;
+    std::cout << "Suspects remaining: " << suspects.count() << std::endl;
 
-    std::vector<std::string> half1, half2;
-    splitSuspects(half1, half2);
+    EnablePlan plan;
+    if (strategy == SearchStrategy::LIKELY_FIRST) {
+        plan = planLikelySplit();
+    } else if (auto balanced = planBalancedSplit(suspects.count() / 2)) {
+        plan = std::move(*balanced);
+    } else {
+        ModBitset half1, half2;
+        splitSuspects(half1, half2);
+
+        // Dependencies of what is kept stay enabled even if they were in the half being disabled,
+        // and mods that were disabled before the search keep anything needing them disabled.
+        // If that pulls every suspect back in, keep the other half, then drop the innocent mods
+        // (whose dependencies may be suspects) from what is kept.
+        const ModBitset candidates[] = {half2 | innocent, half1 | innocent, half2, half1};
+        for (const auto& keep : candidates) {
+            plan = modManager.planEnabledMods(keep, allMods);
+            if ((suspects - plan.enabled).any()) break;
+        }
+    }
+    currentlyEnabled = plan.enabled;
+
+    const ModBitset disabledSuspects = suspects - currentlyEnabled;
+    if (disabledSuspects.none()) {
+        std::cout << "\n=== Search Failed ===" << std::endl;
+        std::cout << "The remaining suspects all depend on each other and cannot be split:" << std::endl;
+        for (const auto& modId : idsOf(suspects)) {
+            std::cout << "  - " << modId << std::endl;
+        }
+        state = SearchState::FAILED;
+        return false;
+    }
+
+    std::cout << "\nDisabling " << disabledSuspects.count() << " mods (keeping "
+              << (suspects & currentlyEnabled).count() << " enabled):" << std::endl;
+    for (const auto& modId : idsOf(disabledSuspects)) {
+        std::cout << "  - " << modId << std::endl;
+    }
+
+    if (strategy == SearchStrategy::LIKELY_FIRST) {
+        std::cout << "Chance the culprit is still enabled: "
+                  << std::lround(probabilityOf(suspects & currentlyEnabled) * 100) << "%" << std::endl;
+    }
+
+    pendingConfigs = {currentlyEnabled};
+    applyTestPlan(plan);
+    return true;
+}
+
+bool BinarySearchEngine::nextParallelIteration() {
+    iteration++;
+    std::cout << "\n=== Round " << iteration << " ===" << std::endl;
+    std::cout << "Suspects remaining: " << suspects.count() << std::endl;
+
+    // k tests cut the suspects into k+1 groups; the last is the one no test enables, and
+    // all of them enabled is known to fail
+    const size_t groups = std::min(parallelism + 1, suspects.count());
+    std::vector<ModBitset> configs;
+    for (size_t group = 1; group < groups; ++group) {
+        const auto plan = planBalancedSplit(suspects.count() * group / groups);
+        if (plan && std::ranges::find(configs, plan->enabled) == configs.end()) {
+            configs.push_back(plan->enabled);
+        }
+    }
+
+    if (configs.empty()) {
+        std::cout << "\n=== Search Failed ===" << std::endl;
+        std::cout << "The remaining suspects all depend on each other and cannot be split:" << std::endl;
+        for (const auto& modId : idsOf(suspects)) {
+            std::cout << "  - " << modId << std::endl;
+        }
+        state = SearchState::FAILED;
+        return false;
+    }
+
+    const auto& mods = modManager.getMods();
+    for (size_t test = 0; test < configs.size(); ++test) {
+        std::vector<fs::path> jars;
+        configs[test].forEach([&](ModHandle handle) { jars.emplace_back(mods[handle].jarPath); });
+
+        if (!testInstances->prepare(test, jars)) {
+            std::cerr << "Failed to set up test instance " << test + 1 << std::endl;
+            state = SearchState::FAILED;
+            return false;
+        }
+
+        std::cout << "\nTest " << test + 1 << ": " << (suspects & configs[test]).count() << " suspects enabled ("
+                  << configs[test].count() << " mods)" << std::endl;
+        std::cout << "  Game directory: " << testInstances->gameDirectory(test).string() << std::endl;
+    }
+
+    pendingConfigs = std::move(configs);
+
+    std::cout << "\n*** Please run Minecraft from each game directory now ('launch' starts them all) ***" << std::endl;
+    std::cout << "After testing, report every result in order, for example 'results s f s'" << std::endl;
+    std::cout << "  (s: problem GONE, f: problem PERSISTS, ?: could not tell)" << std::endl;
+    return true;
+}
+
+bool BinarySearchEngine::nextDeltaDebugIteration() {
+    const auto requested = deltaDebugger.next();
+    suspects = deltaDebugger.getFailing();
 
-    std::cout << "\nDisabling " << half1.size() << " mods (keeping " << half2.size() << " enabled):" << std::endl;
-    for (const auto& modId : half1) {
+    if (!requested) {
+        std::cout << "\n=== Search Complete ===" << std::endl;
+        if (suspects.count() == 1) {
+            std::cout << "Problematic mod identified: " << idsOf(suspects)[0] << std::endl;
+        } else {
+            std::cout << "These mods cause the problem together; removing any one of them fixes it:" << std::endl;
+            for (const auto& modId : idsOf(suspects)) {
+                std::cout << "  - " << modId << std::endl;
+            }
+        }
+        state = SearchState::COMPLETED;
+        return false;
+    }
+
+    iteration++;
+    std::cout << "\n=== Iteration " << iteration << " ===" << std::endl;
+    std::cout << "Failing set: " << suspects.count() << " mods, split into "
+              << deltaDebugger.getGranularity() << " parts" << std::endl;
+
+    const EnablePlan plan = modManager.planEnabledMods(*requested, allMods);
+    currentlyEnabled = plan.enabled;
+
+    const ModBitset disabledSuspects = suspects - currentlyEnabled;
+    std::cout << "\nDisabling " << disabledSuspects.count() << " of them (keeping "
+              << (suspects & currentlyEnabled).count() << " enabled):" << std::endl;
+    for (const auto& modId : idsOf(disabledSuspects)) {
         std::cout << "  - " << modId << std::endl;
     }
 
-    std::unordered_set keepEnabled(half2.begin(), half2.end());
-    keepEnabled.insert(innocent.begin(), innocent.end());
+    applyTestPlan(plan);
+    return true;
+}
+
+bool BinarySearchEngine::nextGroupTestIteration() {
+    const auto requested = groupTester.next();
+    const ModBitset& culprits = groupTester.getCulprits();
+    suspects = groupTester.getSuspects();
+
+    if (!requested) {
+        const ModBitset& blocked = groupTester.getBlocked();
+        if (culprits.none()) {
+            std::cout << "\n=== Search Failed ===" << std::endl;
+            std::cout << "No single mod causes the problem on its own (try 'start ddmin')." << std::endl;
+            state = SearchState::FAILED;
+            return false;
+        }
+
+        std::cout << "\n=== Search Complete ===" << std::endl;
+        std::cout << "Found " << culprits.count() << " problematic mod(s):" << std::endl;
+        for (const auto& modId : idsOf(culprits)) {
+            std::cout << "  - " << modId << std::endl;
+        }
+        if (blocked.any()) {
+            std::cout << "Not tested, as they cannot load without one of those:" << std::endl;
+            for (const auto& modId : idsOf(blocked)) {
+                std::cout << "  - " << modId << std::endl;
+            }
+        }
 
-    modManager.disableAllExcept(keepEnabled);
-    currentlyDisabled = half1;
+        suspects = culprits;
+        state = SearchState::COMPLETED;
+        return false;
+    }
+
+    iteration++;
+    std::cout << "\n=== Iteration " << iteration << " ===" << std::endl;
+    std::cout << "Suspects remaining: " << suspects.count() << ", culprits found: " << culprits.count() << std::endl;
+
+    const EnablePlan plan = modManager.planEnabledMods(*requested, allMods - culprits);
+    currentlyEnabled = plan.enabled;
+    innocent = allMods - suspects - culprits - groupTester.getBlocked();
+
+    const ModBitset testedSuspects = suspects & currentlyEnabled;
+    std::cout << "\nTesting " << testedSuspects.count() << " suspects (with " << (innocent & currentlyEnabled).count()
+              << " cleared mods and without the culprits found so far):" << std::endl;
+    for (const auto& modId : idsOf(testedSuspects)) {
+        std::cout << "  - " << modId << std::endl;
+    }
+
+    applyTestPlan(plan);
+    return true;
+}
+
+void BinarySearchEngine::applyTestPlan(const EnablePlan& plan) {
+    modManager.applyPlan(plan);
 
     std::cout << "\n*** Please test Minecraft now ***" << std::endl;
     std::cout << "After testing, report the result:" << std::endl;
     std::cout << "  - If problem is GONE -> type 'success'" << std::endl;
     std::cout << "  - If problem PERSISTS -> type 'failure'" << std::endl;
-
-    return true;
 }
 
 void BinarySearchEngine::reportResult(TestResult result) {
@@ -72,47 +278,121 @@ void BinarySearchEngine::reportResult(TestResult result) {
         return;
     }
 
-    if (result == TestResult::SUCCESS) {
-        std::cout << "\nProblem resolved! Culprit is in disabled set." << std::endl;
-        suspects = currentlyDisabled;
+    if (!checkModList()) return;
 
-        for (const auto& modId : modManager.getEnabledModIds()) {
-            if (std::ranges::find(innocent, modId) == innocent.end()) {
-                innocent.push_back(modId);
-            }
+    if (strategy == SearchStrategy::DELTA_DEBUG) {
+        if (result == TestResult::SUCCESS) {
+            std::cout << "\nProblem resolved! These mods alone do not cause it." << std::endl;
+            deltaDebugger.reportSuccess();
+        } else if (result == TestResult::FAILURE) {
+            std::cout << "\nProblem persists. Narrowing down to the enabled mods." << std::endl;
+            deltaDebugger.reportFailure();
+        } else {
+            deltaDebugger.reportUnresolved();
         }
 
+        nextIteration();
+        return;
+    }
+
+    if (strategy == SearchStrategy::ALL_CULPRITS) {
+        if (result == TestResult::SUCCESS) {
+            std::cout << "\nProblem resolved! The tested suspects are cleared." << std::endl;
+            groupTester.reportSuccess();
+        } else if (result == TestResult::FAILURE) {
+            std::cout << "\nProblem persists. A culprit is among the tested suspects." << std::endl;
+            groupTester.reportFailure();
+        } else {
+            std::cout << "\nNo clear result. Retrying the same test." << std::endl;
+            groupTester.reportUnresolved();
+        }
+
+        nextIteration();
+        return;
+    }
+
+    if (pendingConfigs.size() != 1) {
+        std::cerr << "This round runs " << pendingConfigs.size() << " tests; report all of their results together"
+                  << std::endl;
+        return;
+    }
+
+    if (result == TestResult::SUCCESS) {
+        std::cout << "\nProblem resolved! Culprit is in disabled set." << std::endl;
     } else if (result == TestResult::FAILURE) {
         std::cout << "\nProblem persists. Culprit is in enabled set." << std::endl;
+    }
 
-        std::vector<std::string> newSuspects;
-        for (const auto& modId : modManager.getEnabledModIds()) {
-            if (std::ranges::find(innocent, modId) == innocent.end()) {
-                newSuspects.push_back(modId);
-            }
+    if (applyResults({result})) nextIteration();
+}
+
+void BinarySearchEngine::reportResults(const std::vector<TestResult>& results) {
+    if (results.size() == 1 && pendingConfigs.size() <= 1) {
+        reportResult(results[0]);
+        return;
+    }
+
+    if (state != SearchState::IN_PROGRESS) {
+        std::cerr << "No search in progress" << std::endl;
+        return;
+    }
+
+    if (!checkModList()) return;
+
+    if (results.size() != pendingConfigs.size()) {
+        std::cerr << "Expected " << pendingConfigs.size() << " results, one per test" << std::endl;
+        return;
+    }
+
+    const auto failures = std::ranges::count(results, TestResult::FAILURE);
+    std::cout << "\nProblem persisted in " << failures << " of " << results.size() << " tests." << std::endl;
+
+    if (applyResults(results)) nextIteration();
+}
+
+std::vector<fs::path> BinarySearchEngine::getTestGameDirectories() const {
+    std::vector<fs::path> directories;
+    if (!testInstances) return directories;
+
+    for (size_t test = 0; test < pendingConfigs.size(); ++test) {
+        directories.push_back(testInstances->gameDirectory(test));
+    }
+    return directories;
+}
+
+bool BinarySearchEngine::applyResults(const std::vector<TestResult>& results) {
+    // With one culprit, a test fails exactly when it enables it
+    for (size_t test = 0; test < results.size(); ++test) {
+        if (results[test] == TestResult::SUCCESS) {
+            suspects -= pendingConfigs[test];
+            innocent |= pendingConfigs[test];
+        } else if (results[test] == TestResult::FAILURE) {
+            suspects &= pendingConfigs[test];
+            innocent |= allMods - pendingConfigs[test];
         }
-        suspects = newSuspects;
-        innocent.insert(innocent.end(), currentlyDisabled.begin(), currentlyDisabled.end());
     }
+    pendingConfigs.clear();
+
+    if (strategy == SearchStrategy::LIKELY_FIRST) updatePosterior();
 
-    if (suspects.size() == 1) {
+    if (suspects.count() == 1) {
         std::cout << "\n=== Search Complete ===" << std::endl;
-        std::cout << "Problematic mod identified: " << suspects[0] << std::endl;
+        std::cout << "Problematic mod identified: " << idsOf(suspects)[0] << std::endl;
         state = SearchState::COMPLETED;
-        return;
+        return false;
     }
 
-    if (suspects.empty()) {
+    if (suspects.none()) {
         std::cout << "\n=== Search Failed ===" << std::endl;
         std::cout << "Could not identify a single problematic mod." << std::endl;
         std::cout << "Possible reasons:" << std::endl;
-        std::cout << "  - Multiple mods causing the issue together" << std::endl;
+        std::cout << "  - Multiple mods causing the issue together (try 'start ddmin')" << std::endl;
         std::cout << "  - Problem is not mod-related" << std::endl;
         state = SearchState::FAILED;
-        return;
+        return false;
     }
 
-    nextIteration();
+    return true;
 }
 
 bool BinarySearchEngine::isComplete() const {
@@ -120,8 +400,8 @@ bool BinarySearchEngine::isComplete() const {
 }
 
 std::vector<std::string> BinarySearchEngine::getCulprits() const {
-    if (state == SearchState::COMPLETED && !suspects.empty()) {
-        return suspects;
+    if (state == SearchState::COMPLETED && suspects.any()) {
+        return idsOf(suspects);
     }
     return {};
 }
@@ -129,8 +409,8 @@ std::vector<std::string> BinarySearchEngine::getCulprits() const {
 std::string BinarySearchEngine::getProgressReport() const {
     std::string report;
     report += "Iteration: " + std::to_string(iteration) + "\n";
-    report += "Suspects: " + std::to_string(suspects.size()) + "\n";
-    report += "Innocent: " + std::to_string(innocent.size()) + "\n";
+    report += "Suspects: " + std::to_string(suspects.count()) + "\n";
+    report += "Innocent: " + std::to_string(innocent.count()) + "\n";
 
     if (state == SearchState::COMPLETED) {
         report += "Status: COMPLETED\n";
@@ -144,17 +424,202 @@ std::string BinarySearchEngine::getProgressReport() const {
 }
 
 void BinarySearchEngine::reset() {
-    suspects.clear();
-    innocent.clear();
-    currentlyDisabled.clear();
-    allMods.clear();
+    suspects = ModBitset();
+    innocent = ModBitset();
+    currentlyEnabled = ModBitset();
+    allMods = ModBitset();
+    posterior.clear();
+    pendingConfigs.clear();
     iteration = 0;
     state = SearchState::NOT_STARTED;
     modManager.enableAllMods();
+
+    if (testInstances) {
+        testInstances->clear();
+        testInstances.reset();
+    }
 }
 
-void BinarySearchEngine::splitSuspects(std::vector<std::string>& half1, std::vector<std::string>& half2) {
-    size_t midpoint = suspects.size() / 2;
-    half1.assign(suspects.begin(), suspects.begin() + midpoint);
-    half2.assign(suspects.begin() + midpoint, suspects.end());
+void BinarySearchEngine::computePriors() {
+    const auto& mods = modManager.getMods();
+    posterior.assign(mods.size(), 0.0);
+
+    // Stack frames name the crashing mod's callers and libraries too, so the log only gets
+    // part of the weight; a mixin or loading error points at the culprit more directly
+    std::vector<ModHandle> blamed;
+    if (crashEvidence) {
+        for (const auto& modId : crashEvidence->suspectedMods) {
+            const auto handle = modManager.findHandle(modManager.resolveProvider(modId));
+            if (handle && suspects.test(*handle) && std::ranges::find(blamed, *handle) == blamed.end()) {
+                blamed.push_back(*handle);
+            }
+        }
+    }
+
+    double evidenceWeight = 0.0;
+    if (!blamed.empty()) {
+        evidenceWeight = crashEvidence->isMixinError || crashEvidence->isModLoadingError ? 0.7 : 0.5;
+    } else if (!crashEvidence) {
+        std::cout << "No crash log analyzed; run 'analyze' first for a likelihood-guided split" << std::endl;
+    } else {
+        std::cout << "No mod from the analyzed crash log is enabled; splitting evenly" << std::endl;
+    }
+
+    const double share = (1.0 - evidenceWeight) / static_cast<double>(suspects.count());
+    suspects.forEach([&](ModHandle handle) { posterior[handle] = share; });
+
+    // Earlier in the stack (the primary suspect first) weighs more
+    double rankTotal = 0.0;
+    for (size_t rank = 0; rank < blamed.size(); ++rank) rankTotal += 1.0 / static_cast<double>(rank + 1);
+    for (size_t rank = 0; rank < blamed.size(); ++rank) {
+        posterior[blamed[rank]] += evidenceWeight / static_cast<double>(rank + 1) / rankTotal;
+    }
+
+    if (!blamed.empty()) {
+        std::cout << "Most likely culprit from the crash log: " << modManager.getMods()[blamed[0]].id << std::endl;
+    }
+}
+
+void BinarySearchEngine::updatePosterior() {
+    const double total = probabilityOf(suspects);
+    for (ModHandle handle = 0; handle < posterior.size(); ++handle) {
+        posterior[handle] = suspects.test(handle) && total > 0 ? posterior[handle] / total : 0.0;
+    }
+}
+
+EnablePlan BinarySearchEngine::planLikelySplit() const {
+    std::vector<ModHandle> ranked;
+    ranked.reserve(suspects.count());
+    suspects.forEach([&](ModHandle handle) { ranked.push_back(handle); });
+    std::ranges::stable_sort(ranked, std::greater{}, [&](ModHandle handle) { return posterior[handle]; });
+
+    // The most likely suspects up to about half the probability, either side of the halfway
+    // point, kept or disabled, and the plain halves. Each is also tried without the innocent
+    // mods, which may need a suspect that is meant to be disabled (as with bisecting).
+    ModBitset below(allMods.size());
+    ModBitset above(allMods.size());
+    double probability = 0.0;
+    for (const ModHandle handle : ranked) {
+        above.set(handle);
+        probability += posterior[handle];
+        if (probability >= 0.5) break;
+        below.set(handle);
+    }
+
+    ModBitset half1, half2;
+    splitSuspects(half1, half2);
+
+    const ModBitset splits[] = {above, suspects - above, below, suspects - below, half2, half1};
+    std::vector<ModBitset> candidates;
+    for (const auto& keep : splits) candidates.push_back(keep | innocent);
+    for (const auto& keep : splits) candidates.push_back(keep);
+
+    // The outcome is certain given the culprit, so a test tells as much as the entropy of
+    // its result: most when the culprit is equally likely to be enabled or disabled
+    EnablePlan best;
+    double bestGain = -1.0;
+    for (const auto& keep : candidates) {
+        EnablePlan plan = modManager.planEnabledMods(keep, allMods);
+        if ((suspects - plan.enabled).none()) {
+            if (bestGain < 0.0) best = std::move(plan);
+            continue;
+        }
+
+        const double p = std::clamp(probabilityOf(suspects & plan.enabled), 0.0, 1.0);
+        const double gain = p <= 0.0 || p >= 1.0 ? 0.0 : -p * std::log2(p) - (1 - p) * std::log2(1 - p);
+        if (gain > bestGain) {
+            best = std::move(plan);
+            bestGain = gain;
+        }
+    }
+
+    return best;
+}
+
+double BinarySearchEngine::probabilityOf(const ModBitset& handles) const {
+    double probability = 0.0;
+    handles.forEach([&](ModHandle handle) { probability += posterior[handle]; });
+    return probability;
+}
+
+std::vector<ModHandle> BinarySearchEngine::dependencyOrder() const {
+    std::vector<ModHandle> order;
+    order.reserve(suspects.count());
+    suspects.forEach([&](ModHandle handle) { order.push_back(handle); });
+
+    // Components are numbered dependencies-first, and in the order a depth-first walk finishes
+    // them, so a library sits just before the first mod that needs it
+    const DependencyGraph& graph = modManager.getDependencyGraph();
+    std::ranges::stable_sort(order, {}, [&](ModHandle handle) { return graph.componentOf(handle); });
+    return order;
+}
+
+void BinarySearchEngine::splitSuspects(ModBitset& half1, ModBitset& half2) const {
+    const std::vector<ModHandle> order = dependencyOrder();
+
+    half1 = ModBitset(allMods.size());
+    for (size_t i = 0; i < order.size() / 2; ++i) half1.set(order[i]);
+    half2 = suspects - half1;
+}
+
+std::optional<EnablePlan> BinarySearchEngine::planBalancedSplit(size_t target) const {
+    const std::vector<ModHandle> order = dependencyOrder();
+
+    std::optional<EnablePlan> best;
+    size_t bestDistance = SIZE_MAX;
+
+    // A prefix only pulls in suspects that the innocent mods need, and the count it enables
+    // only grows with its length, so the prefix closest to the target is found by binary search
+    const auto consider = [&](const ModBitset& base, size_t length) {
+        ModBitset keep = base;
+        for (size_t i = 0; i < length; ++i) keep.set(order[i]);
+
+        EnablePlan plan = modManager.planEnabledMods(keep, allMods);
+        const size_t enabled = (suspects & plan.enabled).count();
+        if (enabled == 0 || enabled == suspects.count()) return enabled;
+
+        const size_t distance = enabled > target ? enabled - target : target - enabled;
+        if (distance < bestDistance) {
+            best = std::move(plan);
+            bestDistance = distance;
+        }
+        return enabled;
+    };
+
+    // Keeping the innocent mods enabled is preferred, as when bisecting; they may need suspects
+    for (const ModBitset& base : {innocent, ModBitset(allMods.size())}) {
+        size_t low = 1;
+        size_t high = order.size() - 1;
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            if (consider(base, mid) < target) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        consider(base, low);
+        if (low > 1) consider(base, low - 1);
+
+        if (bestDistance == 0) break;
+    }
+
+    return best;
+}
+
+std::vector<std::string> BinarySearchEngine::idsOf(const ModBitset& handles) const {
+    std::vector<std::string> ids;
+    ids.reserve(handles.count());
+
+    const auto& mods = modManager.getMods();
+    handles.forEach([&](ModHandle handle) { ids.push_back(mods[handle].id); });
+    return ids;
+}
+
+bool BinarySearchEngine::checkModList() {
+    if (modManager.getModListVersion() == modListVersion) return true;
+
+    std::cerr << "The mod list changed during the search; start a new search" << std::endl;
+    state = SearchState::FAILED;
+    return false;
 }
\ No newline at end of file
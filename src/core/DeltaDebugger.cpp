@@ -0,0 +1,141 @@
+#include "DeltaDebugger.h"
+#include <algorithm>
+
+void DeltaDebugger::start(const ModBitset& initial, Closure closureFn) {
+    closure = std::move(closureFn);
+    universe = initial;
+    failing = initial;
+    failingConfig = closure(failing);
+    confirmed = ModBitset(initial.size());
+    granularity = 2;
+    pending.reset();
+    pendingPushDown.reset();
+    passedConfigs.clear();
+    split();
+}
+
+std::optional<ModBitset> DeltaDebugger::next() {
+    pendingPushDown.reset();
+
+    while (failing.count() > 1) {
+        if (partIndex == parts.size()) {
+            // With two parts the complements are the subsets again
+            if (!testingComplements && granularity > 2) {
+                testingComplements = true;
+                partIndex = 0;
+                continue;
+            }
+
+            // Nothing smaller fails at this granularity: refine, or stop once parts are single mods
+            if (granularity >= failing.count()) break;
+            granularity = std::min(granularity * 2, failing.count());
+            split();
+            continue;
+        }
+
+        const ModBitset candidate = candidateAt(partIndex);
+        const ModBitset config = closure(candidate);
+
+        if (isKnownToPass(config)) {
+            partIndex++;
+            continue;
+        }
+        if ((failingConfig - config).none()) {
+            reduceTo(candidate, config);
+            continue;
+        }
+
+        pending = candidate;
+        return candidate;
+    }
+
+    // 1-minimal. A mod may only be in the set for what it pulls in, so try each one's
+    // dependencies in its place; if that still fails, minimise again from there.
+    for (ModHandle mod = 0; mod < failing.size(); ++mod) {
+        if (!failing.test(mod) || confirmed.test(mod)) continue;
+
+        ModBitset self(failing.size());
+        self.set(mod);
+        const ModBitset dependencies = (closure(self) - self) & universe;
+
+        ModBitset candidate = failing - self;
+        candidate |= dependencies;
+        const ModBitset config = closure(candidate);
+
+        if (dependencies.none() || config.test(mod) || isKnownToPass(config)) {
+            confirmed.set(mod);
+            continue;
+        }
+
+        pending = candidate;
+        pendingPushDown = mod;
+        return candidate;
+    }
+
+    pending.reset();
+    return std::nullopt;
+}
+
+void DeltaDebugger::reportFailure() {
+    if (!pending) return;
+
+    const ModBitset candidate = *pending;
+    pending.reset();
+    reduceTo(candidate, closure(candidate));
+}
+
+void DeltaDebugger::reportSuccess() {
+    if (!pending) return;
+
+    passedConfigs.push_back(closure(*pending));
+    pending.reset();
+    advance();
+}
+
+void DeltaDebugger::reportUnresolved() {
+    if (!pending) return;
+
+    pending.reset();
+    advance();
+}
+
+void DeltaDebugger::advance() {
+    if (pendingPushDown) {
+        confirmed.set(*pendingPushDown);
+    } else {
+        partIndex++;
+    }
+}
+
+void DeltaDebugger::split() {
+    parts.clear();
+    partIndex = 0;
+    testingComplements = false;
+
+    // Consecutive handles, sizes differing by at most one
+    ModBitset rest = failing;
+    for (size_t i = 0; i < granularity && rest.any(); ++i) {
+        const size_t size = rest.count() / (granularity - i);
+        ModBitset part = rest.lowest(std::max<size_t>(size, 1));
+        rest -= part;
+        parts.push_back(std::move(part));
+    }
+}
+
+void DeltaDebugger::reduceTo(const ModBitset& candidate, const ModBitset& config) {
+    const bool wasComplement = testingComplements && !pendingPushDown;
+
+    failing = candidate;
+    failingConfig = config;
+    granularity = wasComplement ? std::max<size_t>(granularity - 1, 2) : 2;
+    granularity = std::min(granularity, std::max<size_t>(failing.count(), 1));
+    split();
+}
+
+bool DeltaDebugger::isKnownToPass(const ModBitset& config) const {
+    return std::ranges::any_of(passedConfigs, [&](const ModBitset& passed) { return (config - passed).none(); });
+}
+
+ModBitset DeltaDebugger::candidateAt(size_t index) const {
+    return testingComplements ? failing - parts[index] : parts[index];
+}
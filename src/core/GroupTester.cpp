@@ -0,0 +1,133 @@
+#include "GroupTester.h"
+#include <algorithm>
+#include <bit>
+
+void GroupTester::start(const ModBitset& failing, Planner plannerFn) {
+    planner = std::move(plannerFn);
+
+    suspects = failing;
+    innocent = ModBitset(failing.size());
+    culprits = ModBitset(failing.size());
+    blocked = ModBitset(failing.size());
+    pendingTested.reset();
+    pendingRequest.reset();
+
+    // Everything enabled is known to fail, so the first test already narrows it down
+    contaminated = failing;
+    phase = Phase::SPLIT;
+}
+
+std::optional<ModBitset> GroupTester::next() {
+    if (pendingTested) return pendingRequest;
+
+    std::optional<ModBitset> request;
+
+    while (!request) {
+        if (phase != Phase::SPLIT && suspects.none()) return std::nullopt;
+
+        switch (phase) {
+            case Phase::CHECK_REST:
+                propose(suspects, request);
+                break;
+
+            case Phase::GROUPS: {
+                // Once earlier groups have passed, the next one may cover every suspect still
+                // known to hold a culprit; it would fail, so split that set without the launch
+                const ModBitset group = suspects.lowest(groupSize());
+                contaminated &= suspects;
+                if (contaminated.any() && (contaminated - group).none()) {
+                    phase = Phase::SPLIT;
+                    break;
+                }
+                propose(group, request);
+                break;
+            }
+
+            case Phase::SPLIT: {
+                contaminated &= suspects;
+                if (contaminated.count() <= 1) {
+                    addCulprits(contaminated);
+                    break;
+                }
+
+                // Either half will do, as long as its dependencies don't drag the whole group back in
+                const ModBitset half1 = contaminated.lowest(contaminated.count() / 2);
+                for (const auto& half : {half1, contaminated - half1}) {
+                    const ModBitset config = planner(half | innocent, culprits);
+                    const ModBitset tested = config & suspects;
+                    if ((contaminated - tested).any() && tested.count() < contaminated.count()) {
+                        propose(half, request);
+                        break;
+                    }
+                }
+
+                // Mods that need each other: they can only be blamed together
+                if (!request) addCulprits(contaminated);
+                break;
+            }
+        }
+    }
+
+    return request;
+}
+
+void GroupTester::reportFailure() {
+    if (!pendingTested) return;
+
+    // Whatever was enabled holds a culprit; what was left out stays a suspect
+    contaminated = *pendingTested;
+    pendingTested.reset();
+
+    // Rather than halving all that is left, look for a group of about n/d holding one
+    if (phase == Phase::CHECK_REST && groupSize() < suspects.count()) {
+        phase = Phase::GROUPS;
+    } else {
+        phase = Phase::SPLIT;
+    }
+}
+
+void GroupTester::reportSuccess() {
+    if (!pendingTested) return;
+
+    innocent |= *pendingTested;
+    suspects -= *pendingTested;
+    contaminated -= *pendingTested;
+    pendingTested.reset();
+}
+
+bool GroupTester::propose(const ModBitset& group, std::optional<ModBitset>& request) {
+    const ModBitset requested = group | innocent;
+    const ModBitset config = planner(requested, culprits);
+
+    // Left out of their own test: they need a mod that has to stay disabled
+    const ModBitset untestable = group - config;
+    blocked |= untestable;
+    suspects -= untestable;
+
+    const ModBitset tested = config & suspects;
+    if (tested.none()) return false;
+
+    pendingTested = tested;
+    pendingRequest = requested;
+    request = requested;
+    return true;
+}
+
+void GroupTester::addCulprits(const ModBitset& found) {
+    culprits |= found;
+    suspects -= found;
+
+    // Mods needing a culprit are left out of later tests by the planner and end up blocked
+    contaminated = ModBitset(suspects.size());
+    phase = Phase::CHECK_REST;
+}
+
+size_t GroupTester::groupSize() const {
+    const size_t n = suspects.count();
+
+    // At least one culprit is left (the rest failed); guess as many again as were found
+    const size_t d = std::max<size_t>(culprits.count(), 1);
+    if (n <= 2 * d - 2) return 1;
+
+    return std::bit_floor((n - d + 1) / d);
+}
@@ -1,209 +1,771 @@
 #include "ModManager.h"
 #include "JarReader.h"
+#include "ModCache.h"
+#include "ParallelFor.h"
+#include "UringReader.h"
+#include "ToggleJournal.h"
+#include "DirectoryRenamer.h"
 #include <iostream>
 #include <algorithm>
 #include <utility>
+#include <iterator>
 
 ModManager::ModManager(std::string& modsDirectory)
-    : modsDir(std::move(modsDirectory)) {
+    : modsDir(normalizeModsDirectory(modsDirectory)), modSetFarm(modsDir) {
+    modSetFarm.recover();
+
     if (!fs::exists(modsDir)) {
         throw std::runtime_error("Mods directory does not exist: " + modsDir);
     }
+
+    // Finish any enable/disable batch a previous run was killed in the middle of
+    ToggleJournal::getInstance().recover();
 }
 
 bool ModManager::scanMods() {
     mods.clear();
-    modIdToPath.clear();
+    providedMods.clear();
 
     std::cout << "Scanning mods in: " << modsDir << std::endl;
 
+    std::vector<fs::path> jarFiles;
+    for (const auto& entry : fs::directory_iterator(modsDir)) {
+        if (entry.is_regular_file() && isModFile(entry.path())) {
+            jarFiles.push_back(entry.path());
+        }
+    }
+
+    std::ranges::sort(jarFiles, [](const fs::path& a, const fs::path& b) {
+        return a.filename() < b.filename();
+    });
+
+    ModCache& cache = ModCache::getInstance();
+    cache.load();
+
+    std::vector<JarScanResult> results(jarFiles.size());
+    if (UringReader::isSupported()) {
+        scanJarsBatched(jarFiles, cache, results);
+    } else {
+        parallelFor(jarFiles.size(), scanThreads, [&](size_t i) {
+            results[i] = scanJar(jarFiles[i], cache);
+        });
+    }
+
+    std::unordered_set<std::string> presentJars;
+    for (const auto& result : results) {
+        presentJars.insert(result.jarPath);
+        if (result.cacheUpdate) {
+            cache.store(result.jarPath, *result.cacheUpdate);
+        }
+    }
+    cache.prune(modsDir, presentJars);
+    cache.save();
+
     int jarCount = 0;
     int loadedCount = 0;
 
-    for (const auto& entry : fs::directory_iterator(modsDir)) {
-        if (!entry.is_regular_file()) continue;
+    for (auto& result : results) {
+        jarCount++;
 
-        std::string filename = entry.path().filename().string();
-        std::string jarPath = entry.path().string();
-        bool isDisabledMod = false;
+        const std::string status = result.isDisabled ? "[DISABLED]" : "[OK]";
+        switch (result.outcome) {
+            case JarScanResult::Outcome::NoModJson:
+                std::cout << "  [SKIP] " << result.displayName << " - No fabric.mod.json found" << std::endl;
+                continue;
+            case JarScanResult::Outcome::ParseError:
+                std::cerr << "  [ERROR] " << result.displayName << " - Failed to parse fabric.mod.json" << std::endl;
+                continue;
+            case JarScanResult::Outcome::Loaded:
+                break;
+        }
+
+        std::cout << "  " << status << " " << result.mod.id << " v" << result.mod.version
+                  << " (" << result.displayName << ")" << std::endl;
+
+        mods.push_back(std::move(result.mod));
+        std::ranges::move(result.nestedMods, std::back_inserter(providedMods));
+        loadedCount++;
+    }
+
+    rebuildIndexes();
+
+    std::cout << "\nLoaded " << loadedCount << " mods from " << jarCount << " JAR files" << std::endl;
+    if (!providedMods.empty()) {
+        std::cout << "Found " << providedMods.size() << " nested mods inside "
+                  << nestedByContainer.size() << " JAR files" << std::endl;
+    }
+
+    return loadedCount > 0;
+}
+
+bool ModManager::applyJarAdded(const fs::path& filePath) {
+    if (!isModFile(filePath) || !fs::is_regular_file(filePath)) return false;
+
+    ModCache& cache = ModCache::getInstance();
+    cache.load();
+
+    JarScanResult result = scanJar(filePath, cache);
+    if (result.cacheUpdate) {
+        cache.store(result.jarPath, *result.cacheUpdate);
+        cache.save();
+    }
 
-        if (filename.ends_with(".disabled")) {
-            jarPath = jarPath.substr(0, jarPath.length() - 9);
-            isDisabledMod = true;
+    removeModsForJar(result.jarPath);
+
+    switch (result.outcome) {
+        case JarScanResult::Outcome::NoModJson:
+            std::cout << "  [SKIP] " << result.displayName << " - No fabric.mod.json found" << std::endl;
+            break;
+        case JarScanResult::Outcome::ParseError:
+            std::cerr << "  [ERROR] " << result.displayName << " - Failed to parse fabric.mod.json" << std::endl;
+            break;
+        case JarScanResult::Outcome::Loaded: {
+            std::cout << "  [ADDED] " << result.mod.id << " v" << result.mod.version
+                      << " (" << result.displayName << ")" << std::endl;
+
+            const auto position = std::ranges::upper_bound(mods, fs::path(result.jarPath).filename(), {},
+                [](const ModInfo& mod) { return fs::path(mod.jarPath).filename(); });
+            mods.insert(position, std::move(result.mod));
+            std::ranges::move(result.nestedMods, std::back_inserter(providedMods));
+            break;
         }
-        else if (!filename.ends_with(".jar")) {
-            continue;
+    }
+
+    rebuildIndexes();
+    return true;
+}
+
+bool ModManager::applyJarRemoved(const fs::path& filePath) {
+    if (!isModFile(filePath)) return false;
+
+    // The other half of an enable/disable toggle is still there, so the mod didn't go anywhere
+    const std::string jarPath = canonicalJarPath(filePath);
+    if (fs::exists(jarPath) || fs::exists(getDisabledPath(jarPath))) return false;
+
+    if (!removeModsForJar(jarPath)) return false;
+
+    std::cout << "  [REMOVED] " << fs::path(jarPath).filename().string() << std::endl;
+    rebuildIndexes();
+    return true;
+}
+
+bool ModManager::applyJarRenamed(const fs::path& fromPath, const fs::path& toPath) {
+    if (!isModFile(fromPath)) return applyJarAdded(toPath);
+    if (!isModFile(toPath)) return applyJarRemoved(fromPath);
+
+    const std::string fromJar = canonicalJarPath(fromPath);
+    const std::string toJar = canonicalJarPath(toPath);
+
+    // foo.jar <-> foo.jar.disabled is a toggle (usually our own); the contents didn't change
+    if (fromJar == toJar) {
+        if (const auto it = handleByJar.find(fromJar); it != handleByJar.end()) {
+            setToggleState(it->second, !toPath.filename().string().ends_with(".disabled"));
         }
+        return false;
+    }
 
-        jarCount++;
+    bool moved = false;
+    for (auto& mod : mods) {
+        if (mod.jarPath == fromJar) {
+            mod.jarPath = toJar;
+            moved = true;
+        }
+    }
+    if (!moved) return applyJarAdded(toPath);
 
-        std::string actualFilePath = entry.path().string();
-        auto jsonContent = JarReader::extractFabricModJson(actualFilePath);
-        if (!jsonContent) {
-            std::string displayName = isDisabledMod ? filename.substr(0, filename.length() - 9) : filename;
-            std::cout << "  [SKIP] " << displayName << " - No fabric.mod.json found" << std::endl;
-            continue;
+    for (auto& nested : providedMods) {
+        if (nested.jarPath == fromJar) {
+            nested.jarPath = toJar;
         }
+    }
 
-        ModInfo mod;
-        mod.jarPath = jarPath;
+    // Renaming keeps size and mtime, so the cached parse stays valid under the new name
+    ModCache& cache = ModCache::getInstance();
+    if (const ModCacheEntry* entry = cache.find(fromJar)) {
+        cache.store(toJar, *entry);
+        cache.save();
+    }
 
-        if (!mod.parseFromJson(*jsonContent)) {
-            std::string displayName = isDisabledMod ? filename.substr(0, filename.length() - 9) : filename;
-            std::cerr << "  [ERROR] " << displayName << " - Failed to parse fabric.mod.json" << std::endl;
-            continue;
+    std::ranges::stable_sort(mods, {}, [](const ModInfo& mod) { return fs::path(mod.jarPath).filename(); });
+
+    std::cout << "  [RENAMED] " << fs::path(fromJar).filename().string() << " -> "
+              << fs::path(toJar).filename().string() << std::endl;
+    rebuildIndexes();
+    return true;
+}
+
+bool ModManager::removeModsForJar(const std::string& jarPath) {
+    const auto removed = std::erase_if(mods, [&](const ModInfo& mod) { return mod.jarPath == jarPath; });
+    std::erase_if(providedMods, [&](const ModInfo& mod) { return mod.jarPath == jarPath; });
+    return removed > 0;
+}
+
+void ModManager::rebuildIndexes() {
+    providedModIndex.clear();
+    nestedByContainer.clear();
+    modTable.build(mods, providedMods);
+    dependencyGraph.build(modTable);
+    modListVersion++;
+
+    handleByJar.clear();
+    for (ModHandle handle = 0; handle < modTable.size(); ++handle) {
+        handleByJar.emplace(modTable.jarPath(handle), handle);
+    }
+
+    // The only time the enabled state is read back from disk, besides watcher events
+    toggleState = readToggleState();
+
+    for (size_t i = 0; i < providedMods.size(); ++i) {
+        nestedByContainer[providedMods[i].providedBy].push_back(i);
+        providedModIndex.try_emplace(providedMods[i].id, i);
+    }
+
+    classIndex.clear();
+    classIndexBuilt = false;
+}
+
+bool ModManager::isModFile(const fs::path& filePath) {
+    const std::string filename = filePath.filename().string();
+    return filename.ends_with(".jar") || filename.ends_with(".disabled");
+}
+
+std::string ModManager::canonicalJarPath(const fs::path& filePath) {
+    std::string path = filePath.string();
+    if (path.ends_with(".disabled")) {
+        path.resize(path.length() - 9);
+    }
+    return path;
+}
+
+std::string ModManager::normalizeModsDirectory(const std::string& directory) {
+    std::error_code ec;
+    fs::path path = fs::absolute(directory, ec).lexically_normal();
+    if (!path.has_filename()) path = path.parent_path();
+    return path.string();
+}
+
+ModManager::JarScanResult ModManager::scanJar(const fs::path& filePath, const ModCache& cache) {
+    JarScanResult result;
+    ModCacheEntry entry;
+
+    if (!lookupCache(filePath, cache, result, entry)) {
+        // One open per JAR: the mod JSON and any nested JARs both come out of the
+        // same central directory index
+        if (const auto jar = JarArchive::open(filePath.string())) {
+            if (readModJson(*jar, cache.find(result.jarPath), entry)) {
+                entry.nestedMods = scanNestedJars(*jar, entry.mod);
+            }
+            result.cacheUpdate = entry;
         }
+    }
 
-        std::string status = isDisabledMod ? "[DISABLED]" : "[OK]";
-        std::string displayName = isDisabledMod ? filename.substr(0, filename.length() - 9) : filename;
-        std::cout << "  " << status << " " << mod.id << " v" << mod.version << " (" << displayName << ")" << std::endl;
+    finishScan(result, entry);
+    return result;
+}
 
-        mods.push_back(mod);
-        modIdToPath[mod.id] = jarPath;
-        loadedCount++;
+void ModManager::scanJarsBatched(const std::vector<fs::path>& jarFiles, const ModCache& cache,
+                                 std::vector<JarScanResult>& results) const {
+    std::vector<ModCacheEntry> entries(jarFiles.size());
+    std::vector<char> upToDate(jarFiles.size());
+    parallelFor(jarFiles.size(), scanThreads, [&](size_t i) {
+        upToDate[i] = lookupCache(jarFiles[i], cache, results[i], entries[i]);
+    });
+
+    std::vector<size_t> changed;
+    for (size_t i = 0; i < jarFiles.size(); ++i) {
+        if (!upToDate[i]) changed.push_back(i);
     }
 
-    std::cout << "\nLoaded " << loadedCount << " mods from " << jarCount << " JAR files" << std::endl;
+    // Each round reads in three batches instead of a chain of small reads per JAR:
+    // tails and central directories (openAll), then every fabric.mod.json, then the
+    // nested JARs those name. Parsing in between runs on the pool.
+    for (size_t begin = 0; begin < changed.size(); begin += SCAN_BATCH_SIZE) {
+        const size_t count = std::min(SCAN_BATCH_SIZE, changed.size() - begin);
 
-    return loadedCount > 0;
+        std::vector<std::string> paths;
+        for (size_t k = 0; k < count; ++k) {
+            paths.push_back(jarFiles[changed[begin + k]].string());
+        }
+
+        auto archives = JarArchive::openAll(paths);
+
+        std::vector<std::pair<JarArchive*, const JarEntry*>> wanted;
+        for (auto& jar : archives) {
+            if (!jar) continue;
+            if (const JarEntry* modJson = jar->find("fabric.mod.json")) {
+                wanted.emplace_back(&*jar, modJson);
+            }
+        }
+        JarArchive::prefetch(wanted);
+
+        std::vector<char> parsed(count);
+        parallelFor(count, scanThreads, [&](size_t k) {
+            if (!archives[k]) return;
+            const size_t i = changed[begin + k];
+            parsed[k] = readModJson(*archives[k], cache.find(results[i].jarPath), entries[i]);
+        });
+
+        wanted.clear();
+        for (size_t k = 0; k < count; ++k) {
+            if (!parsed[k]) continue;
+            for (const JarEntry* entry : bundledEntries(*archives[k], entries[changed[begin + k]].mod)) {
+                wanted.emplace_back(&*archives[k], entry);
+            }
+        }
+        JarArchive::prefetch(wanted);
+
+        parallelFor(count, scanThreads, [&](size_t k) {
+            if (!archives[k]) return;
+            const size_t i = changed[begin + k];
+            if (parsed[k]) {
+                entries[i].nestedMods = scanNestedJars(*archives[k], entries[i].mod);
+            }
+            results[i].cacheUpdate = entries[i];
+        });
+    }
+
+    for (size_t i = 0; i < jarFiles.size(); ++i) {
+        finishScan(results[i], entries[i]);
+    }
 }
 
-const ModInfo* ModManager::getModById(const std::string& modId) const {
-    const auto it = std::ranges::find_if(mods,
-                                         [&modId](const ModInfo& mod) { return mod.id == modId; });
+bool ModManager::lookupCache(const fs::path& filePath, const ModCache& cache,
+                             JarScanResult& result, ModCacheEntry& entry) {
+    std::string filename = filePath.filename().string();
+    std::string jarPath = filePath.string();
+
+    if (filename.ends_with(".disabled")) {
+        jarPath = jarPath.substr(0, jarPath.length() - 9);
+        filename = filename.substr(0, filename.length() - 9);
+        result.isDisabled = true;
+    }
+    result.displayName = filename;
+    result.jarPath = jarPath;
 
-    return (it != mods.end()) ? &(*it) : nullptr;
+    std::error_code ec;
+    entry.fileSize = fs::file_size(filePath, ec);
+    entry.modifiedTime = fs::last_write_time(filePath, ec).time_since_epoch().count();
+
+    const ModCacheEntry* cached = cache.find(jarPath);
+    if (cached && cached->fileSize == entry.fileSize && cached->modifiedTime == entry.modifiedTime) {
+        entry = *cached;
+        return true;
+    }
+
+    return false;
 }
 
-bool ModManager::disableMods(const std::vector<std::string>& modIds) {
-    bool allSuccess = true;
+bool ModManager::readModJson(const JarArchive& jar, const ModCacheEntry* cached, ModCacheEntry& entry) {
+    const JarEntry* modJson = jar.find("fabric.mod.json");
+    if (!modJson) return false;
 
-    for (const auto& modId : modIds) {
-        auto it = modIdToPath.find(modId);
-        if (it == modIdToPath.end()) {
-            std::cerr << "Mod not found: " << modId << std::endl;
-            allSuccess = false;
-            continue;
+    entry.modJsonCrc = modJson->crc32;
+
+    if (cached && cached->modJsonCrc == entry.modJsonCrc) {
+        // Same fabric.mod.json under a new identity (e.g. re-downloaded); keep the parse
+        entry.parsed = cached->parsed;
+        entry.mod = cached->mod;
+        entry.nestedMods = cached->nestedMods;
+        return false;
+    }
+
+    if (const auto jsonContent = jar.read(*modJson)) {
+        // A deflated entry's payload already is the compressed copy ModInfo keeps
+        const auto payload = modJson->compressionMethod == 8 ? jar.rawData(*modJson) : std::nullopt;
+        entry.parsed = payload
+            ? entry.mod.parseFromJson(*jsonContent, CompressedText::fromDeflated(*payload, modJson->uncompressedSize))
+            : entry.mod.parseFromJson(*jsonContent);
+    }
+    return entry.parsed;
+}
+
+std::vector<const JarEntry*> ModManager::bundledEntries(const JarArchive& jar, const ModInfo& mod) {
+    std::vector<const JarEntry*> entries;
+    for (const auto& name : mod.jars) {
+        if (const JarEntry* entry = jar.find(name)) {
+            entries.push_back(entry);
         }
+    }
+    return entries;
+}
+
+void ModManager::finishScan(JarScanResult& result, ModCacheEntry& entry) {
+    if (!entry.modJsonCrc) {
+        result.outcome = JarScanResult::Outcome::NoModJson;
+        return;
+    }
 
-        const std::string& jarPath = it->second;
-        std::string disabledPath = getDisabledPath(jarPath);
+    if (!entry.parsed) {
+        result.outcome = JarScanResult::Outcome::ParseError;
+        return;
+    }
+
+    result.mod = std::move(entry.mod);
+    result.mod.jarPath = result.jarPath;
+    result.nestedMods = std::move(entry.nestedMods);
+    for (auto& nested : result.nestedMods) {
+        nested.jarPath = result.jarPath;
+    }
+    result.outcome = JarScanResult::Outcome::Loaded;
+}
 
-        try {
-            if (fs::exists(jarPath)) {
-                fs::rename(jarPath, disabledPath);
-                std::cout << "Disabled: " << modId << std::endl;
-            } else if (fs::exists(disabledPath)) {
-                std::cout << "Already disabled: " << modId << std::endl;
-            } else {
-                std::cerr << "File not found: " << jarPath << std::endl;
-                allSuccess = false;
+std::vector<ModInfo> ModManager::scanNestedJars(const JarArchive& jar, const ModInfo& container) {
+    std::vector<ModInfo> nestedMods;
+
+    JarReader::visitNestedJars(jar, container.jars,
+        [&](const std::string& entryPath, const std::string& modJson) -> std::vector<std::string> {
+            ModInfo nested;
+            if (!nested.parseFromJson(modJson)) {
+                std::cerr << "  [ERROR] " << entryPath << " in " << container.id
+                          << " - Failed to parse fabric.mod.json" << std::endl;
+                return {};
             }
-        } catch (const fs::filesystem_error& e) {
-            std::cerr << "Error disabling " << modId << ": " << e.what() << std::endl;
-            allSuccess = false;
+
+            nested.providedBy = container.id;
+            auto innerJars = nested.jars;
+            nestedMods.push_back(std::move(nested));
+            return innerJars;
+        });
+
+    return nestedMods;
+}
+
+const ModInfo* ModManager::getModById(const std::string& modId) const {
+    if (const auto handle = findHandle(modId)) return &mods[*handle];
+
+    const auto nestedIt = providedModIndex.find(modId);
+    return nestedIt != providedModIndex.end() ? &providedMods[nestedIt->second] : nullptr;
+}
+
+std::optional<ModHandle> ModManager::findHandle(const std::string& modId) const {
+    return modTable.findHandle(modId);
+}
+
+const ClassIndex& ModManager::getClassIndex() const {
+    if (classIndexBuilt) return classIndex;
+
+    std::vector<ClassIndex::JarClasses> jarClasses(mods.size());
+    parallelFor(mods.size(), scanThreads, [&](size_t i) {
+        const ModInfo& mod = mods[i];
+        const std::string path = isEnabled(i) ? mod.jarPath : getDisabledPath(mod.jarPath);
+
+        if (const auto jar = JarArchive::open(path)) {
+            jarClasses[i] = ClassIndex::collectClasses(*jar, mod.id);
+        }
+    });
+
+    classIndex.build(std::move(jarClasses));
+    classIndexBuilt = true;
+
+    std::cout << "Indexed " << classIndex.size() << " classes from " << mods.size() << " mods" << std::endl;
+
+    return classIndex;
+}
+
+std::string ModManager::resolveProvider(const std::string& modId) const {
+    const auto symbol = modTable.findSymbol(modId);
+    const auto provider = symbol ? modTable.providerOf(*symbol) : std::nullopt;
+    return provider ? std::string(modTable.id(*provider)) : modId;
+}
+
+bool ModManager::disableMods(const std::vector<std::string>& modIds) {
+    bool allFound = true;
+    ModBitset disable(modTable.size());
+
+    for (const auto& modId : modIds) {
+        if (const auto handle = findHandle(modId)) {
+            disable.set(*handle);
+        } else {
+            std::cerr << "Mod not found: " << modId << std::endl;
+            allFound = false;
         }
     }
 
-    return allSuccess;
+    return applyToggles(ModBitset(modTable.size()), disable, true) && allFound;
 }
 
 bool ModManager::enableMods(const std::vector<std::string>& modIds) {
-    bool allSuccess = true;
+    bool allFound = true;
+    ModBitset enable(modTable.size());
 
     for (const auto& modId : modIds) {
-        auto it = modIdToPath.find(modId);
-        if (it == modIdToPath.end()) {
+        if (const auto handle = findHandle(modId)) {
+            enable.set(*handle);
+        } else {
             std::cerr << "Mod not found: " << modId << std::endl;
-            allSuccess = false;
-            continue;
+            allFound = false;
         }
+    }
 
-        const std::string& jarPath = it->second;
-        std::string disabledPath = getDisabledPath(jarPath);
+    return applyToggles(enable, ModBitset(modTable.size()), true) && allFound;
+}
 
-        try {
-            if (fs::exists(disabledPath)) {
-                fs::rename(disabledPath, jarPath);
-                std::cout << "Enabled: " << modId << std::endl;
-            } else if (fs::exists(jarPath)) {
-                std::cout << "Already enabled: " << modId << std::endl;
-            } else {
-                std::cerr << "File not found: " << disabledPath << std::endl;
-                allSuccess = false;
-            }
-        } catch (const fs::filesystem_error& e) {
-            std::cerr << "Error enabling " << modId << ": " << e.what() << std::endl;
-            allSuccess = false;
+bool ModManager::disableAllExcept(const std::unordered_set<std::string>& keepEnabled) {
+    ModBitset keep(modTable.size());
+    for (const auto& modId : keepEnabled) {
+        if (const auto handle = findHandle(resolveProvider(modId))) {
+            keep.set(*handle);
         }
     }
 
-    return allSuccess;
+    return setEnabledMods(keep);
 }
 
-bool ModManager::disableAllExcept(const std::unordered_set<std::string>& keepEnabled) {
-    const auto required = getRequiredDependencies(keepEnabled);
+bool ModManager::setEnabledMods(const ModBitset& enabled) {
+    return applyPlan(planEnabledMods(enabled, ModBitset(modTable.size(), true)));
+}
 
-    std::vector<std::string> toDisable;
-    for (const auto& mod : mods) {
-        if (!required.contains(mod.id)) {
-            toDisable.push_back(mod.id);
+EnablePlan ModManager::planEnabledMods(const ModBitset& requested, const ModBitset& allowed) const {
+    EnablePlan plan;
+
+    // Anything that would drag in a mod that is not allowed can't be enabled either; what
+    // survives is closed under dependencies and avoids those mods entirely
+    const ModBitset blocked = getRequiredDependencies(requested) - allowed;
+    const ModBitset unusable = blocked.any() ? dependencyGraph.dependentClosureOf(blocked) : ModBitset(modTable.size());
+    plan.enabled = getRequiredDependencies(requested - unusable);
+
+    // Name a requested mod as the reason where one needs it directly, so cycles among
+    // pulled-in mods don't explain each other
+    (plan.enabled - requested).forEach([&](ModHandle handle) {
+        const auto dependents = dependencyGraph.dependents(handle);
+        const auto direct = std::ranges::find_if(dependents, [&](ModHandle d) { return requested.test(d) && plan.enabled.test(d); });
+        const auto any = std::ranges::find_if(dependents, [&](ModHandle d) { return plan.enabled.test(d); });
+
+        if (direct != dependents.end()) {
+            plan.pulledIn.push_back({handle, *direct});
+        } else if (any != dependents.end()) {
+            plan.pulledIn.push_back({handle, *any});
+        }
+    });
+
+    ((requested & unusable) - blocked).forEach([&](ModHandle handle) {
+        for (const ModHandle dependency : dependencyGraph.dependencies(handle)) {
+            if (unusable.test(dependency)) {
+                plan.pushedOut.push_back({handle, dependency});
+                break;
+            }
         }
+    });
+
+    return plan;
+}
+
+bool ModManager::applyPlan(const EnablePlan& plan) {
+    for (const auto& [mod, because] : plan.pulledIn) {
+        std::cout << "Keeping " << modTable.id(mod) << " enabled: required by " << modTable.id(because) << std::endl;
+    }
+    for (const auto& [mod, because] : plan.pushedOut) {
+        std::cout << "Keeping " << modTable.id(mod) << " disabled: needs " << modTable.id(because)
+                  << ", which stays disabled" << std::endl;
     }
 
-    return disableMods(toDisable);
+    return applyToggles(plan.enabled, ModBitset(modTable.size(), true) - plan.enabled, false);
 }
 
 bool ModManager::enableAllMods() {
-    std::vector<std::string> allModIds;
-    for (const auto& mod : mods) {
-        allModIds.push_back(mod.id);
+    return applyToggles(ModBitset(modTable.size(), true), ModBitset(modTable.size()), false);
+}
+
+bool ModManager::setSymlinkFarm(bool enabled) {
+    if (enabled == modSetFarm.isActive()) return true;
+
+    if (enabled ? modSetFarm.convert() : modSetFarm.revert()) {
+        std::cout << (enabled ? "Mod sets are now switched through a symlink: "
+                              : "Mods are now toggled by renaming them in place: ")
+                  << modsDir << std::endl;
+        return true;
+    }
+
+    std::cerr << "Failed to " << (enabled ? "set up" : "remove") << " the symlinked mods directory" << std::endl;
+    return false;
+}
+
+ModManager::ToggleState ModManager::readToggleState() const {
+    ToggleState state{ModBitset(modTable.size()), ModBitset(modTable.size())};
+
+    // One listing instead of up to two stats per mod
+    std::unordered_set<std::string> files;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(modsDir, ec)) {
+        files.insert(entry.path().string());
+    }
+
+    for (ModHandle handle = 0; handle < modTable.size(); ++handle) {
+        const std::string jarPath(modTable.jarPath(handle));
+        if (files.contains(jarPath)) {
+            state.enabled.set(handle);
+        } else if (files.contains(getDisabledPath(jarPath))) {
+            state.disabled.set(handle);
+        }
+    }
+
+    return state;
+}
+
+void ModManager::setToggleState(ModHandle handle, bool enabled) {
+    if (enabled) {
+        toggleState.enabled.set(handle);
+        toggleState.disabled.reset(handle);
+    } else {
+        toggleState.enabled.reset(handle);
+        toggleState.disabled.set(handle);
+    }
+}
+
+bool ModManager::applyToggles(const ModBitset& enable, const ModBitset& disable, bool reportUnchanged) {
+    const ToggleState& state = toggleState;
+    bool allSuccess = true;
+
+    std::vector<ToggleJournal::Rename> renames;
+    std::vector<ModHandle> renamed;
+
+    enable.forEach([&](ModHandle handle) {
+        const std::string jarPath(modTable.jarPath(handle));
+        if (state.disabled.test(handle)) {
+            renames.push_back({getDisabledPath(jarPath), jarPath});
+            renamed.push_back(handle);
+        } else if (state.enabled.test(handle)) {
+            if (reportUnchanged) std::cout << "Already enabled: " << modTable.id(handle) << std::endl;
+        } else {
+            std::cerr << "File not found: " << getDisabledPath(jarPath) << std::endl;
+            allSuccess = false;
+        }
+    });
+
+    disable.forEach([&](ModHandle handle) {
+        const std::string jarPath(modTable.jarPath(handle));
+        if (state.enabled.test(handle)) {
+            renames.push_back({jarPath, getDisabledPath(jarPath)});
+            renamed.push_back(handle);
+        } else if (state.disabled.test(handle)) {
+            if (reportUnchanged) std::cout << "Already disabled: " << modTable.id(handle) << std::endl;
+        } else {
+            std::cerr << "File not found: " << jarPath << std::endl;
+            allSuccess = false;
+        }
+    });
+
+    if (renames.empty()) return allSuccess;
+
+    if (modSetFarm.isActive()) {
+        std::unordered_map<std::string, bool> enabledByName;
+        for (const ModHandle handle : renamed) {
+            enabledByName[fs::path(modTable.jarPath(handle)).filename().string()] = enable.test(handle);
+        }
+
+        if (!modSetFarm.switchTo(enabledByName)) {
+            std::cerr << "Failed to switch to the new mod set" << std::endl;
+            return false;
+        }
+
+        for (const ModHandle handle : renamed) {
+            setToggleState(handle, enable.test(handle));
+            std::cout << (enable.test(handle) ? "Enabled: " : "Disabled: ") << modTable.id(handle) << std::endl;
+        }
+        return allSuccess;
+    }
+
+    // Recorded first, so an interrupted batch is finished on the next start
+    ToggleJournal& journal = ToggleJournal::getInstance();
+    if (!journal.begin(renames)) {
+        std::cerr << "Could not write the toggle journal; renaming without it" << std::endl;
     }
-    return enableMods(allModIds);
+
+    std::vector<DirectoryRenamer::Rename> batch;
+    batch.reserve(renames.size());
+    for (const auto& [from, to] : renames) {
+        batch.push_back({fs::path(from).filename().string(), fs::path(to).filename().string(), {}});
+    }
+
+    DirectoryRenamer renamer(modsDir);
+    if (!renamer.renameAll(batch)) {
+        // Give transient failures (e.g. a busy network share) one more try, one at a time
+        std::vector<DirectoryRenamer::Rename> retry;
+        std::vector<size_t> retryIndex;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const std::error_code& error = batch[i].error;
+            if (error && error != std::errc::no_such_file_or_directory && error != std::errc::file_exists) {
+                retry.push_back({batch[i].from, batch[i].to, {}});
+                retryIndex.push_back(i);
+            }
+        }
+
+        renamer.renameAll(retry, 1);
+        for (size_t k = 0; k < retry.size(); ++k) {
+            batch[retryIndex[k]].error = retry[k].error;
+        }
+    }
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const bool enabling = enable.test(renamed[i]);
+
+        if (batch[i].error) {
+            std::cerr << "Error " << (enabling ? "enabling " : "disabling ") << modTable.id(renamed[i])
+                      << ": " << batch[i].error.message() << std::endl;
+            allSuccess = false;
+            continue;
+        }
+
+        setToggleState(renamed[i], enabling);
+        std::cout << (enabling ? "Enabled: " : "Disabled: ") << modTable.id(renamed[i]) << std::endl;
+    }
+
+    journal.commit();
+    return allSuccess;
 }
 
 std::unordered_set<std::string> ModManager::getRequiredDependencies(
     const std::unordered_set<std::string>& modIds) const {
 
-    std::unordered_set<std::string> required;
+    std::unordered_set<std::string> required(modIds.begin(), modIds.end());
 
+    ModBitset roots(modTable.size());
     for (const auto& modId : modIds) {
-        required.insert(modId);
-        collectDependencies(modId, required);
+        if (const auto handle = findHandle(resolveProvider(modId))) {
+            roots.set(*handle);
+        }
     }
 
+    // Every JAR in the closure, what it bundles and every ID it needs, installed or not
+    getRequiredDependencies(roots).forEach([&](ModHandle handle) {
+        required.emplace(modTable.id(handle));
+        for (const ModTable::Symbol symbol : modTable.dependencies(handle)) {
+            required.emplace(modTable.name(symbol));
+        }
+
+        if (const auto it = nestedByContainer.find(mods[handle].id); it != nestedByContainer.end()) {
+            for (const size_t index : it->second) {
+                required.insert(providedMods[index].id);
+            }
+        }
+    });
+
     return required;
 }
 
 std::vector<std::string> ModManager::getEnabledModIds() const {
     std::vector<std::string> enabled;
-
-    for (const auto& mod : mods) {
-        if (!isDisabled(mod.jarPath)) {
-            enabled.push_back(mod.id);
-        }
-    }
-
+    getEnabledMods().forEach([&](ModHandle handle) { enabled.emplace_back(modTable.id(handle)); });
     return enabled;
 }
 
+ModBitset ModManager::getEnabledMods() const {
+    // A mod whose file is missing altogether counts as enabled, as it always has
+    return ModBitset(modTable.size(), true) - toggleState.disabled;
+}
+
 std::vector<std::string> ModManager::getDisabledModIds() const {
     std::vector<std::string> disabled;
-
-    for (const auto& mod : mods) {
-        if (isDisabled(mod.jarPath)) {
-            disabled.push_back(mod.id);
-        }
-    }
-
+    toggleState.disabled.forEach([&](ModHandle handle) { disabled.emplace_back(modTable.id(handle)); });
     return disabled;
 }
 
 void ModManager::printModList() const {
     std::cout << "\n=== Loaded Mods ===" << std::endl;
 
-    for (const auto& mod : mods) {
-        std::string status = isDisabled(mod.jarPath) ? "[DISABLED]" : "[ENABLED] ";
+    for (ModHandle handle = 0; handle < mods.size(); ++handle) {
+        const ModInfo& mod = mods[handle];
+        std::string status = isEnabled(handle) ? "[ENABLED] " : "[DISABLED]";
         std::cout << status << " " << mod.id << " v" << mod.version;
 
         if (!mod.depends.empty()) {
@@ -218,6 +780,24 @@ void ModManager::printModList() const {
         }
 
         std::cout << std::endl;
+
+        if (!mod.provides.empty()) {
+            std::cout << "           provides: ";
+            for (size_t i = 0; i < mod.provides.size(); ++i) {
+                if (i > 0) std::cout << ", ";
+                std::cout << mod.provides[i];
+            }
+            std::cout << std::endl;
+        }
+
+        if (const auto it = nestedByContainer.find(mod.id); it != nestedByContainer.end()) {
+            std::cout << "           bundles: ";
+            for (size_t i = 0; i < it->second.size(); ++i) {
+                if (i > 0) std::cout << ", ";
+                std::cout << providedMods[it->second[i]].id;
+            }
+            std::cout << std::endl;
+        }
     }
 
     std::cout << "===================\n" << std::endl;
@@ -235,30 +815,34 @@ void ModManager::printDependencyGraph() const {
         }
     }
 
-    std::cout << "========================\n" << std::endl;
-}
+    // Mods in a dependency cycle can only be enabled or disabled together
+    std::vector<std::vector<ModHandle>> components(dependencyGraph.componentCount());
+    for (ModHandle handle = 0; handle < modTable.size(); ++handle) {
+        components[dependencyGraph.componentOf(handle)].push_back(handle);
+    }
 
-void ModManager::collectDependencies(const std::string& modId,
-                                     std::unordered_set<std::string>& result) const {
-    const ModInfo* mod = getModById(modId);
-    if (!mod) return;
+    for (const auto& members : components) {
+        if (members.size() < 2) continue;
 
-    for (const auto &depId: mod->depends | std::views::keys) {
-        if (result.insert(depId).second) {
-            collectDependencies(depId, result);
+        std::cout << "Dependency cycle:";
+        for (const ModHandle handle : members) {
+            std::cout << " " << modTable.id(handle);
         }
+        std::cout << std::endl;
     }
-}
 
-std::string ModManager::getDisabledPath(const std::string& jarPath) const {
-    return jarPath + ".disabled";
+    std::cout << "========================\n" << std::endl;
 }
 
-bool ModManager::isDisabled(const std::string& jarPath) const {
-    return !fs::exists(jarPath) && fs::exists(getDisabledPath(jarPath));
+std::string ModManager::getDisabledPath(std::string_view jarPath) const {
+    return std::string(jarPath) + ".disabled";
 }
 
 void ModManager::setModsDirectory(const std::string& newModsDirectory) {
+    // A conversion cut short leaves mods/ missing until it is finished
+    ModSetFarm newModSetFarm(newModsDirectory);
+    newModSetFarm.recover();
+
     if (!fs::exists(newModsDirectory)) {
         throw std::runtime_error("Directory does not exist: " + newModsDirectory);
     }
@@ -267,9 +851,13 @@ void ModManager::setModsDirectory(const std::string& newModsDirectory) {
         throw std::runtime_error("Path is not a directory: " + newModsDirectory);
     }
 
-    modsDir = newModsDirectory;
+    modsDir = normalizeModsDirectory(newModsDirectory);
+    modSetFarm = std::move(newModSetFarm);
     mods.clear();
-    modIdToPath.clear();
+    providedMods.clear();
+    rebuildIndexes();
+    classIndex.clear();
+    classIndexBuilt = false;
 
     std::cout << "Mods directory changed to: " << modsDir << std::endl;
     std::cout << "Run 'scan' to load mods from the new directory." << std::endl;
@@ -0,0 +1,162 @@
+#include "ModWatcher.h"
+#include <iostream>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+ModWatcher::ModWatcher(ModManager& manager)
+    : modManager(manager) {}
+
+ModWatcher::~ModWatcher() {
+    stop();
+}
+
+bool ModWatcher::isSupported() {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ModWatcher::start() {
+#ifdef __linux__
+    stop();
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        std::cerr << "Failed to initialize inotify: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    watchedDir = modManager.getModsDirectory();
+    if (!addWatch()) {
+        stop();
+        return false;
+    }
+
+    std::cout << "Watching for changes in: " << watchedDir << std::endl;
+    return true;
+#else
+    std::cerr << "Watching the mods directory is only supported on Linux" << std::endl;
+    return false;
+#endif
+}
+
+void ModWatcher::stop() {
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+    }
+#endif
+    inotifyFd = -1;
+    watchDescriptor = -1;
+}
+
+bool ModWatcher::addWatch() {
+#ifdef __linux__
+    constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE |
+                              IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+    watchDescriptor = inotify_add_watch(inotifyFd, watchedDir.c_str(), mask);
+    if (watchDescriptor < 0) {
+        std::cerr << "Failed to watch " << watchedDir << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+int ModWatcher::poll() {
+#ifdef __linux__
+    if (inotifyFd < 0) return 0;
+
+    // Follow the manager if it was pointed at another directory
+    if (modManager.getModsDirectory() != watchedDir) {
+        if (!start()) return 0;
+    }
+
+    struct Event {
+        int wd;
+        uint32_t mask;
+        uint32_t cookie;
+        std::string name;
+    };
+    std::vector<Event> events;
+
+    alignas(inotify_event) char buffer[16 * 1024];
+    while (true) {
+        const ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break;
+
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            events.push_back({event->wd, event->mask, event->cookie, event->len > 0 ? std::string(event->name) : ""});
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+
+    const fs::path dir(watchedDir);
+    int changes = 0;
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        const Event& event = events[i];
+
+        if (event.mask & IN_Q_OVERFLOW) {
+            std::cout << "Too many changes in mods directory, rescanning..." << std::endl;
+            modManager.scanMods();
+            return changes + 1;
+        }
+
+        if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+            if (event.wd != watchDescriptor) continue;
+
+            // A symlinked mods directory was switched to another mod set (see ModSetFarm)
+            std::error_code ec;
+            if (fs::is_directory(watchedDir, ec)) {
+                inotify_rm_watch(inotifyFd, watchDescriptor);
+                if (addWatch()) continue;
+            }
+
+            std::cerr << "Mods directory was removed or moved, stopped watching: " << watchedDir << std::endl;
+            stop();
+            return changes;
+        }
+
+        if (event.name.empty()) continue;
+
+        if (event.mask & IN_MOVED_FROM) {
+            // A rename inside the directory arrives as MOVED_FROM/MOVED_TO sharing a cookie
+            size_t match = i + 1;
+            while (match < events.size() &&
+                   !((events[match].mask & IN_MOVED_TO) && events[match].cookie == event.cookie)) {
+                ++match;
+            }
+
+            if (match < events.size()) {
+                changes += modManager.applyJarRenamed(dir / event.name, dir / events[match].name);
+                events[match].mask = 0;
+            } else {
+                changes += modManager.applyJarRemoved(dir / event.name);
+            }
+
+        } else if (event.mask & (IN_MOVED_TO | IN_CLOSE_WRITE)) {
+            changes += modManager.applyJarAdded(dir / event.name);
+
+        } else if (event.mask & IN_DELETE) {
+            changes += modManager.applyJarRemoved(dir / event.name);
+        }
+    }
+
+    return changes;
+#else
+    return 0;
+#endif
+}
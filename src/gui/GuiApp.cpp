@@ -9,6 +9,7 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
 
 namespace fs = std::filesystem;
 
@@ -16,6 +17,16 @@ static void glfw_error_callback(int error, const char* description) {
     std::cerr << "GLFW Error " << error << ": " << description << std::endl;
 }
 
+static std::string describeCulprits(const std::vector<std::string>& culprits, SearchStrategy strategy) {
+    if (culprits.size() == 1) return "Found culprit: " + culprits[0];
+
+    std::string message = strategy == SearchStrategy::ALL_CULPRITS ? "Found culprits:" : "Found mods that fail together:";
+    for (size_t i = 0; i < culprits.size(); ++i) {
+        message += (i == 0 ? " " : ", ") + culprits[i];
+    }
+    return message;
+}
+
 GuiApp::GuiApp() {
     const std::string home = std::getenv("HOME") ? std::getenv("HOME") : "";
 
@@ -127,6 +138,10 @@ void GuiApp::renderMainWindow() {
 
     ImGui::Begin("MainWindow", nullptr, window_flags);
 
+    if (modWatcher && modWatcher->poll() > 0) {
+        statusMessage = "Mods folder changed. Mod list updated.";
+    }
+
     if (ImGui::BeginMenuBar()) {
         if (ImGui::BeginMenu("File")) {
             if (ImGui::MenuItem("Settings...")) {
@@ -270,6 +285,10 @@ void GuiApp::renderSetupPanel() {
             ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f),
                              "Loaded %zu mods", modManager->getMods().size());
 
+            if (ModWatcher::isSupported() && ImGui::Checkbox("Watch mods folder for changes", &watchModsFolder)) {
+                updateModWatcher();
+            }
+
             ImGui::Spacing();
             ImGui::Separator();
             ImGui::Spacing();
@@ -296,8 +315,7 @@ void GuiApp::renderModListPanel() const {
 
         ImGui::BeginChild("ModListChild", ImVec2(0, 0), false);
 
-        const auto modsCopy = modManager->getMods();
-        auto enabledModIds = modManager->getEnabledModIds();
+        const ModTable& table = modManager->getModTable();
 
         // Use resizable table
         if (ImGui::BeginTable("ModsTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
@@ -308,31 +326,32 @@ void GuiApp::renderModListPanel() const {
             ImGui::TableSetupColumn("Info", ImGuiTableColumnFlags_WidthFixed, 60);
             ImGui::TableHeadersRow();
 
-            for (const auto& mod : modsCopy) {
+            for (ModHandle handle = 0; handle < table.size(); ++handle) {
+                const std::string_view modId = table.id(handle);
+                const std::string_view version = table.version(handle);
+
                 ImGui::TableNextRow();
 
                 ImGui::TableNextColumn();
-                const bool isEnabled = std::ranges::find(enabledModIds,
-                                                   mod.id) != enabledModIds.end();
-
-                if (isEnabled) {
+                if (modManager->isEnabled(handle)) {
                     ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "ENABLED");
                 } else {
                     ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "DISABLED");
                 }
 
                 ImGui::TableNextColumn();
-                ImGui::Text("%s", mod.id.c_str());
+                ImGui::TextUnformatted(modId.data(), modId.data() + modId.size());
 
                 ImGui::TableNextColumn();
-                ImGui::Text("%s", mod.version.c_str());
+                ImGui::TextUnformatted(version.data(), version.data() + version.size());
 
                 ImGui::TableNextColumn();
-                std::string buttonLabel = "Info##" + mod.id;
-                if (ImGui::SmallButton(buttonLabel.c_str())) {
-                    const_cast<GuiApp*>(this)->selectedModId = mod.id;
+                ImGui::PushID(static_cast<int>(handle));
+                if (ImGui::SmallButton("Info")) {
+                    const_cast<GuiApp*>(this)->selectedModId = std::string(modId);
                     const_cast<GuiApp*>(this)->showModMetadata = true;
                 }
+                ImGui::PopID();
             }
 
             ImGui::EndTable();
@@ -350,6 +369,15 @@ void GuiApp::renderBinarySearchPanel() {
         }
 
         if (!searchInProgress) {
+            const char* strategies[] = {"Binary search (one culprit)", "Delta debugging (mods failing together)",
+                                        "Group testing (every culprit)", "Crash log guided (analyze a log first)",
+                                        "Parallel (several game instances at once)"};
+            ImGui::Combo("Strategy", &searchStrategy, strategies, IM_ARRAYSIZE(strategies));
+
+            if (searchStrategy == 4) {
+                ImGui::SliderInt("Instances", &parallelInstances, 2, 16);
+            }
+
             if (ImGui::Button("Start Binary Search", ImVec2(-1, 40))) {
                 startBinarySearch();
             }
@@ -363,10 +391,39 @@ void GuiApp::renderBinarySearchPanel() {
             ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f),
                              "Iteration %d", searchEngine->getCurrentIteration());
 
-            const auto suspects = searchEngine->getSuspects();
-            ImGui::Text("Suspects remaining: %zu", suspects.size());
+            ImGui::Text("Suspects remaining: %zu", searchEngine->getSuspectCount());
 
             ImGui::Separator();
+
+            if (const auto gameDirs = searchEngine->getTestGameDirectories(); gameDirs.size() > 1) {
+                ImGui::TextWrapped("Run Minecraft from each game directory (Launch starts them all) and set each result:");
+                parallelResults.resize(gameDirs.size(), 0);
+
+                for (size_t test = 0; test < gameDirs.size(); ++test) {
+                    ImGui::PushID(static_cast<int>(test));
+                    ImGui::Text("Test %zu: %s", test + 1, gameDirs[test].string().c_str());
+                    ImGui::RadioButton("Gone", &parallelResults[test], 1);
+                    ImGui::SameLine();
+                    ImGui::RadioButton("Persists", &parallelResults[test], 2);
+                    ImGui::SameLine();
+                    ImGui::RadioButton("Unsure", &parallelResults[test], 3);
+                    ImGui::PopID();
+                }
+
+                const bool allSet = std::ranges::none_of(parallelResults, [](int result) { return result == 0; });
+                ImGui::BeginDisabled(!allSet);
+                if (ImGui::Button("Submit Results", ImVec2(-1, 40))) {
+                    reportParallelResults();
+                }
+                ImGui::EndDisabled();
+
+                ImGui::Separator();
+                if (ImGui::Button("Reset Search")) {
+                    resetSearch();
+                }
+                return;
+            }
+
             ImGui::TextWrapped("Test Minecraft now and report the result:");
 
             if (ImGui::Button("Problem GONE (Success)", ImVec2(-1, 40))) {
@@ -493,10 +550,12 @@ void GuiApp::renderStatusBar() const {
 void GuiApp::scanMods() {
     isScanning = true;
     try {
+        modWatcher.reset();
         modManager = std::make_unique<ModManager>(modsPath);
         if (modManager->scanMods()) {
             modsScanned = true;
             searchEngine = std::make_unique<BinarySearchEngine>(*modManager);
+            updateModWatcher();
             statusMessage = "Mods scanned successfully! Loaded " + std::to_string(modManager->getMods().size()) + " mods.";
         } else {
             statusMessage = "Failed to scan mods. No mods found.";
@@ -508,6 +567,20 @@ void GuiApp::scanMods() {
     isScanning = false;
 }
 
+void GuiApp::updateModWatcher() {
+    if (!watchModsFolder || !modManager) {
+        modWatcher.reset();
+        return;
+    }
+
+    modWatcher = std::make_unique<ModWatcher>(*modManager);
+    if (!modWatcher->start()) {
+        modWatcher.reset();
+        watchModsFolder = false;
+        statusMessage = "Failed to watch the mods folder.";
+    }
+}
+
 void GuiApp::startBinarySearch() {
     if (!searchEngine) {
         statusMessage = "Error: Search engine not initialized!";
@@ -515,6 +588,13 @@ void GuiApp::startBinarySearch() {
     }
 
     try {
+        const SearchStrategy strategies[] = {SearchStrategy::BISECT, SearchStrategy::DELTA_DEBUG,
+                                             SearchStrategy::ALL_CULPRITS, SearchStrategy::LIKELY_FIRST,
+                                             SearchStrategy::PARALLEL};
+        searchEngine->setStrategy(strategies[searchStrategy]);
+        searchEngine->setParallelism(parallelInstances);
+        parallelResults.clear();
+        if (lastCrashInfo) searchEngine->setCrashEvidence(*lastCrashInfo);
         searchEngine->startSearch();
         searchInProgress = true;
         statusMessage = "Binary search started! Test Minecraft and report results.";
@@ -531,7 +611,7 @@ void GuiApp::reportSuccess() {
 
     if (searchEngine->isComplete()) {
         if (const auto culprits = searchEngine->getCulprits(); !culprits.empty()) {
-            statusMessage = "Found culprit: " + culprits[0];
+            statusMessage = describeCulprits(culprits, searchEngine->getStrategy());
             searchInProgress = false;
         } else {
             statusMessage = "Search failed - no single culprit found.";
@@ -549,7 +629,7 @@ void GuiApp::reportFailure() {
 
     if (searchEngine->isComplete()) {
         if (const auto culprits = searchEngine->getCulprits(); !culprits.empty()) {
-            statusMessage = "Found culprit: " + culprits[0];
+            statusMessage = describeCulprits(culprits, searchEngine->getStrategy());
             searchInProgress = false;
         } else {
             statusMessage = "Search failed - no single culprit found.";
@@ -560,6 +640,29 @@ void GuiApp::reportFailure() {
     }
 }
 
+void GuiApp::reportParallelResults() {
+    if (!searchEngine) return;
+
+    std::vector<TestResult> results;
+    for (const int result : parallelResults) {
+        results.push_back(result == 1 ? TestResult::SUCCESS : result == 2 ? TestResult::FAILURE : TestResult::UNKNOWN);
+    }
+    parallelResults.clear();
+
+    searchEngine->reportResults(results);
+
+    if (searchEngine->isComplete()) {
+        if (const auto culprits = searchEngine->getCulprits(); !culprits.empty()) {
+            statusMessage = describeCulprits(culprits, searchEngine->getStrategy());
+        } else {
+            statusMessage = "Search failed - no single culprit found.";
+        }
+        searchInProgress = false;
+    } else {
+        statusMessage = "Results recorded! Next round of test instances is ready.";
+    }
+}
+
 void GuiApp::analyzeCrashLog() {
     if (!modsScanned || modsPath.empty()) {
         statusMessage = "Please scan mods first.";
@@ -569,7 +672,7 @@ void GuiApp::analyzeCrashLog() {
     const std::string crashDir = fs::path(modsPath).parent_path().string() + "/crash-reports";
 
     if (const auto latestLog = CrashLogParser::findLatestCrashLog(crashDir)) {
-        lastCrashInfo = CrashLogParser::parseCrashLog(*latestLog);
+        lastCrashInfo = CrashLogParser::parseCrashLog(*latestLog, modManager ? &modManager->getClassIndex() : nullptr);
         if (lastCrashInfo) {
             statusMessage = "Crash log analyzed: " + fs::path(*latestLog).filename().string();
         } else {
@@ -590,7 +693,7 @@ void GuiApp::resetSearch() {
 
 void GuiApp::analyzeCrashLog(const std::string& logPath) {
     isAnalyzing = true;
-    lastCrashInfo = CrashLogParser::parseCrashLog(logPath);
+    lastCrashInfo = CrashLogParser::parseCrashLog(logPath, modManager ? &modManager->getClassIndex() : nullptr);
     isAnalyzing = false;
 
     if (lastCrashInfo) {
@@ -621,7 +724,7 @@ void GuiApp::launchMinecraft() {
     }
 
     try {
-        const MinecraftLauncher launcher(instancePath);
+        MinecraftLauncher launcher(instancePath);
 
         if (!launcher.canLaunch()) {
             statusMessage = "Error: Cannot launch Minecraft from this location.\n"
@@ -642,6 +745,26 @@ void GuiApp::launchMinecraft() {
 
         statusMessage = "Launching Minecraft... Please wait for the game to start.";
 
+        // A parallel round runs one game per test instance
+        if (const auto gameDirs = searchEngine ? searchEngine->getTestGameDirectories() : std::vector<fs::path>();
+            !gameDirs.empty()) {
+            if (!launcher.canLaunchGameDirectory()) {
+                statusMessage = "The custom launch command has no {gameDir} placeholder, so it would start the live "
+                                "instance for every test. Add {gameDir} to it, or start Minecraft from each of:";
+                for (const auto& gameDir : gameDirs) statusMessage += "\n  " + gameDir.string();
+                return;
+            }
+
+            size_t launched = 0;
+            for (const auto& gameDir : gameDirs) {
+                launcher.setGameDirectory(gameDir);
+                if (launcher.launch()) launched++;
+            }
+            statusMessage = "Launched " + std::to_string(launched) + " of " + std::to_string(gameDirs.size()) +
+                            " test instances. Test each one, then submit their results.";
+            return;
+        }
+
         if (launcher.launch()) {
             statusMessage = "Minecraft launched successfully! Test for the issue, then report success or failure.";
         } else {
@@ -926,6 +1049,10 @@ void GuiApp::renderModMetadataModal() {
     if (showModMetadata) {
         ImGui::OpenPopup("Mod Metadata");
         showModMetadata = false;
+
+        // Decompressed and parsed once per opening rather than every frame
+        const ModInfo* selected = modManager ? modManager->getModById(selectedModId) : nullptr;
+        selectedModMetadata = selected ? selected->loadMetadata() : ModMetadata{};
     }
 
     ImVec2 center = ImGui::GetMainViewport()->GetCenter();
@@ -958,6 +1085,7 @@ void GuiApp::renderModMetadataModal() {
         }
 
         const ModInfo& mod = *modIt;
+        const ModMetadata& metadata = selectedModMetadata;
 
         ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "%s", mod.name.c_str());
         ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "ID: %s | Version: %s",
@@ -969,16 +1097,16 @@ void GuiApp::renderModMetadataModal() {
             if (ImGui::BeginTabItem("Overview")) {
                 ImGui::BeginChild("OverviewContent", ImVec2(0, -35), true);
 
-                if (!mod.description.empty()) {
-                    ImGui::TextWrapped("%s", mod.description.c_str());
+                if (!metadata.description.empty()) {
+                    ImGui::TextWrapped("%s", metadata.description.c_str());
                     ImGui::Spacing();
                     ImGui::Separator();
                     ImGui::Spacing();
                 }
 
-                if (!mod.authors.empty()) {
+                if (!metadata.authors.empty()) {
                     ImGui::Text("Authors:");
-                    for (const auto& author : mod.authors) {
+                    for (const auto& author : metadata.authors) {
                         ImGui::BulletText("%s", author.c_str());
                     }
                     ImGui::Spacing();
@@ -1017,19 +1145,19 @@ void GuiApp::renderModMetadataModal() {
 
                 bool hasLinks = false;
 
-                if (!mod.homepage.empty()) {
+                if (!metadata.homepage.empty()) {
                     hasLinks = true;
                     ImGui::Text("Homepage:");
                     ImGui::SameLine();
-                    ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "%s", mod.homepage.c_str());
+                    ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "%s", metadata.homepage.c_str());
                     if (ImGui::IsItemClicked()) {
                         std::string command;
 #ifdef __APPLE__
-                        command = "open \"" + mod.homepage + "\"";
+                        command = "open \"" + metadata.homepage + "\"";
 #elif defined(_WIN32)
-                        command = "start \"\" \"" + mod.homepage + "\"";
+                        command = "start \"\" \"" + metadata.homepage + "\"";
 #else
-                        command = "xdg-open \"" + mod.homepage + "\"";
+                        command = "xdg-open \"" + metadata.homepage + "\"";
 #endif
                         system(command.c_str());
                     }
@@ -1039,19 +1167,19 @@ void GuiApp::renderModMetadataModal() {
                     ImGui::Spacing();
                 }
 
-                if (!mod.sources.empty()) {
+                if (!metadata.sources.empty()) {
                     hasLinks = true;
                     ImGui::Text("Source Code:");
                     ImGui::SameLine();
-                    ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "%s", mod.sources.c_str());
+                    ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "%s", metadata.sources.c_str());
                     if (ImGui::IsItemClicked()) {
                         std::string command;
 #ifdef __APPLE__
-                        command = "open \"" + mod.sources + "\"";
+                        command = "open \"" + metadata.sources + "\"";
 #elif defined(_WIN32)
-                        command = "start \"\" \"" + mod.sources + "\"";
+                        command = "start \"\" \"" + metadata.sources + "\"";
 #else
-                        command = "xdg-open \"" + mod.sources + "\"";
+                        command = "xdg-open \"" + metadata.sources + "\"";
 #endif
                         system(command.c_str());
                     }
@@ -1061,19 +1189,19 @@ void GuiApp::renderModMetadataModal() {
                     ImGui::Spacing();
                 }
 
-                if (!mod.issues.empty()) {
+                if (!metadata.issues.empty()) {
                     hasLinks = true;
                     ImGui::Text("Issue Tracker:");
                     ImGui::SameLine();
-                    ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "%s", mod.issues.c_str());
+                    ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "%s", metadata.issues.c_str());
                     if (ImGui::IsItemClicked()) {
                         std::string command;
 #ifdef __APPLE__
-                        command = "open \"" + mod.issues + "\"";
+                        command = "open \"" + metadata.issues + "\"";
 #elif defined(_WIN32)
-                        command = "start \"\" \"" + mod.issues + "\"";
+                        command = "start \"\" \"" + metadata.issues + "\"";
 #else
-                        command = "xdg-open \"" + mod.issues + "\"";
+                        command = "xdg-open \"" + metadata.issues + "\"";
 #endif
                         system(command.c_str());
                     }
@@ -1084,7 +1212,7 @@ void GuiApp::renderModMetadataModal() {
                 }
 
                 // Display all other contact fields
-                for (const auto& [key, value] : mod.contact) {
+                for (const auto& [key, value] : metadata.contact) {
                     if (key != "homepage" && key != "sources" && key != "issues") {
                         hasLinks = true;
                         ImGui::Text("%s:", key.c_str());
@@ -1123,7 +1251,7 @@ void GuiApp::renderModMetadataModal() {
                 ImGui::BeginChild("RawJsonContent", ImVec2(0, -35), true);
 
                 ImGui::PushFont(ImGui::GetIO().Fonts->Fonts[0]);
-                ImGui::TextUnformatted(mod.rawJson.c_str());
+                ImGui::TextUnformatted(metadata.rawJson.c_str());
                 ImGui::PopFont();
 
                 ImGui::EndChild();
@@ -1168,6 +1296,7 @@ void GuiApp::renderSettingsModal() {
                 ImGui::Spacing();
                 ImGui::TextWrapped("Leave empty to use the built-in launcher. Enter a custom command to override it.");
                 ImGui::TextWrapped("This is useful for third-party launchers or custom launch configurations.");
+                ImGui::TextWrapped("{gameDir} is replaced with the game directory to run, which parallel searches need.");
                 ImGui::Spacing();
                 ImGui::Separator();
                 ImGui::Spacing();
@@ -3,10 +3,13 @@
 #include <filesystem>
 #include <chrono>
 #include <iomanip>
+#include <sstream>
 #include "ModManager.h"
+#include "ModWatcher.h"
 #include "BinarySearchEngine.h"
 #include "CrashLogParser.h"
 #include "MinecraftLauncher.h"
+#include "ModSetFarm.h"
 
 #ifdef BUILD_GUI
 #include "GuiApp.h"
@@ -28,11 +31,17 @@ void printHelp() {
     std::cout << "  scan                  - Scan mods directory" << std::endl;
     std::cout << "  list                  - List all mods" << std::endl;
     std::cout << "  deps                  - Show dependency graph" << std::endl;
+    std::cout << "  watch                 - Toggle watching the mods directory for changes" << std::endl;
+    std::cout << "  farm                  - Toggle switching mod sets through a symlinked mods directory" << std::endl;
     std::cout << "  logs                  - List all crash logs and game logs" << std::endl;
     std::cout << "  analyze [log_file]    - Analyze a crash/game log" << std::endl;
-    std::cout << "  start                 - Start binary search" << std::endl;
+    std::cout << "  start [bisect|ddmin|all|likely|parallel [k]] - Start a search (ddmin: mods that only fail together;" << std::endl;
+    std::cout << "                        all: every mod that fails on its own;" << std::endl;
+    std::cout << "                        likely: test the last analyzed log's suspects first;" << std::endl;
+    std::cout << "                        parallel: test k mod sets at once, 4 by default)" << std::endl;
     std::cout << "  success               - Report test succeeded (problem gone)" << std::endl;
     std::cout << "  failure               - Report test failed (problem persists)" << std::endl;
+    std::cout << "  results <s|f|?>...    - Report every test of a parallel round, in order (? = unknown)" << std::endl;
     std::cout << "  stop                  - Stop binary search and show results" << std::endl;
     std::cout << "  reset                 - Reset and enable all mods" << std::endl;
     std::cout << "  setpath <path>        - Set custom Minecraft instance path" << std::endl;
@@ -113,6 +122,7 @@ int main(int argc, char** argv) {
     try {
         ModManager modManager(modsPath);
         BinarySearchEngine searchEngine(modManager);
+        ModWatcher modWatcher(modManager);
 
         std::cout << "\nType 'help' for available commands\n" << std::endl;
 
@@ -124,6 +134,8 @@ int main(int argc, char** argv) {
 
             if (command.empty()) continue;
 
+            modWatcher.poll();
+
             // Parse command
             size_t spacePos = command.find(' ');
             std::string cmd = command.substr(0, spacePos);
@@ -138,6 +150,19 @@ int main(int argc, char** argv) {
             } else if (cmd == "deps") {
                 modManager.printDependencyGraph();
 
+            } else if (cmd == "watch") {
+                if (modWatcher.isActive()) {
+                    modWatcher.stop();
+                    std::cout << "Stopped watching the mods directory" << std::endl;
+                } else if (!ModWatcher::isSupported()) {
+                    std::cout << "Watching the mods directory is only supported on Linux" << std::endl;
+                } else {
+                    modWatcher.start();
+                }
+
+            } else if (cmd == "farm") {
+                modManager.setSymlinkFarm(!modManager.usesSymlinkFarm());
+
             } else if (cmd == "logs") {
                 fs::path instancePath = fs::path(modManager.getModsDirectory()).parent_path();
                 std::string crashDir = (instancePath / "crash-reports").string();
@@ -224,9 +249,11 @@ int main(int argc, char** argv) {
 
                 // Analyze the log
                 std::cout << "Analyzing: " << logPath << std::endl;
-                auto crashInfo = CrashLogParser::parseCrashLog(logPath);
+                const ClassIndex* classIndex = modManager.getMods().empty() ? nullptr : &modManager.getClassIndex();
+                auto crashInfo = CrashLogParser::parseCrashLog(logPath, classIndex);
 
                 if (crashInfo) {
+                    searchEngine.setCrashEvidence(*crashInfo);
                     std::cout << "\n=== Log Analysis ===" << std::endl;
                     std::cout << "Error: " << crashInfo->errorMessage << std::endl;
                     std::cout << "Type: " << crashInfo->crashType << std::endl;
@@ -249,6 +276,33 @@ int main(int argc, char** argv) {
                 }
 
             } else if (cmd == "start") {
+                if (args == "ddmin") {
+                    searchEngine.setStrategy(SearchStrategy::DELTA_DEBUG);
+                } else if (args == "all") {
+                    searchEngine.setStrategy(SearchStrategy::ALL_CULPRITS);
+                } else if (args == "likely") {
+                    searchEngine.setStrategy(SearchStrategy::LIKELY_FIRST);
+                } else if (args == "parallel" || args.starts_with("parallel ")) {
+                    int instances = 4;
+                    if (args.size() > 9) {
+                        try {
+                            instances = std::stoi(args.substr(9));
+                        } catch (const std::exception&) {
+                            instances = 0;
+                        }
+                    }
+                    if (instances < 1) {
+                        std::cout << "Usage: start parallel [instances]" << std::endl;
+                        continue;
+                    }
+                    searchEngine.setParallelism(instances);
+                    searchEngine.setStrategy(SearchStrategy::PARALLEL);
+                } else if (args.empty() || args == "bisect") {
+                    searchEngine.setStrategy(SearchStrategy::BISECT);
+                } else {
+                    std::cout << "Usage: start [bisect|ddmin|all|likely|parallel [k]]" << std::endl;
+                    continue;
+                }
                 searchEngine.startSearch();
 
             } else if (cmd == "success") {
@@ -257,6 +311,31 @@ int main(int argc, char** argv) {
             } else if (cmd == "failure") {
                 searchEngine.reportResult(TestResult::FAILURE);
 
+            } else if (cmd == "results") {
+                std::vector<TestResult> results;
+                std::istringstream resultStream(args);
+                std::string word;
+                bool valid = true;
+                while (resultStream >> word) {
+                    if (word == "s" || word == "success") {
+                        results.push_back(TestResult::SUCCESS);
+                    } else if (word == "f" || word == "failure") {
+                        results.push_back(TestResult::FAILURE);
+                    } else if (word == "?" || word == "unknown") {
+                        results.push_back(TestResult::UNKNOWN);
+                    } else {
+                        // A typo must not throw away a test's outcome for the whole round
+                        std::cerr << "Unknown result: " << word << std::endl;
+                        valid = false;
+                        break;
+                    }
+                }
+                if (!valid) {
+                    std::cout << "Usage: results <s|success|f|failure|?|unknown>..." << std::endl;
+                    continue;
+                }
+                searchEngine.reportResults(results);
+
             } else if (cmd == "stop") {
                 searchEngine.reset();
                 std::cout << "\n=== Binary Search Stopped ===" << std::endl;
@@ -284,9 +363,13 @@ int main(int argc, char** argv) {
                         }
 
                         // Support both instance root and mods directory
-                        fs::path inputPath(expandedPath);
+                        fs::path inputPath = fs::path(expandedPath).lexically_normal();
+                        if (!inputPath.has_filename()) inputPath = inputPath.parent_path();
                         fs::path modsPath;
 
+                        // A mod-set conversion cut short leaves mods/ missing until it is finished
+                        ModSetFarm(inputPath.filename() == "mods" ? inputPath : inputPath / "mods").recover();
+
                         if (fs::exists(inputPath / "mods")) {
                             // User provided instance root (e.g., .minecraft)
                             modsPath = inputPath / "mods";
@@ -318,6 +401,29 @@ int main(int argc, char** argv) {
                         std::cerr << "  - libraries/ directory" << std::endl;
                         std::cerr << "\nFor third-party launchers, please launch manually from the launcher." << std::endl;
                         std::cerr << "Once in-game, test your issue, then return here and type 'success' or 'failure'." << std::endl;
+                    } else if (const auto gameDirs = searchEngine.getTestGameDirectories(); !gameDirs.empty()) {
+                        if (!launcher.canLaunchGameDirectory()) {
+                            std::cerr << "The custom launch command has no {gameDir} placeholder, so it would start "
+                                         "the live instance for every test." << std::endl;
+                            std::cerr << "Add {gameDir} to it, or start Minecraft from each of these game directories "
+                                         "manually:" << std::endl;
+                            for (const auto& gameDir : gameDirs) {
+                                std::cerr << "  " << gameDir.string() << std::endl;
+                            }
+                            continue;
+                        }
+
+                        size_t launched = 0;
+                        for (size_t test = 0; test < gameDirs.size(); ++test) {
+                            launcher.setGameDirectory(gameDirs[test]);
+                            if (launcher.launch()) {
+                                launched++;
+                            } else {
+                                std::cerr << "Failed to launch test " << test + 1 << "; start it from "
+                                          << gameDirs[test].string() << " manually" << std::endl;
+                            }
+                        }
+                        std::cout << "Launched " << launched << " of " << gameDirs.size() << " test instances" << std::endl;
                     } else {
                         launcher.launch();
                     }
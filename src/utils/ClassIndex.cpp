@@ -0,0 +1,139 @@
+#include "ClassIndex.h"
+#include <algorithm>
+
+namespace {
+
+constexpr int MAX_NESTING_DEPTH = 8;
+
+// Mods sometimes add classes to these, but the classes the index lacks there are the game's
+constexpr std::string_view GAME_PACKAGES[] = {"net/minecraft/", "com/mojang/"};
+
+} // namespace
+
+ClassIndex::JarClasses ClassIndex::collectClasses(const JarArchive& jar, const std::string& owner) {
+    JarClasses result;
+    result.owner = owner;
+    collectFrom(jar, result.classNames, 0);
+    return result;
+}
+
+void ClassIndex::collectFrom(const JarArchive& jar, std::vector<std::string>& classNames, int depth) {
+    for (const auto& entry : jar.entries()) {
+        if (entry.name.ends_with(".class")) {
+            // Module descriptors and multi-release copies don't identify an owner
+            if (entry.name.ends_with("module-info.class") || entry.name.starts_with("META-INF/")) continue;
+            classNames.emplace_back(entry.name.substr(0, entry.name.size() - 6));
+
+        } else if (entry.name.ends_with(".jar") && depth < MAX_NESTING_DEPTH) {
+            // Nested JARs are loaded alongside their container, so their classes count as its own
+            std::optional<JarArchive> nestedJar;
+            if (entry.compressionMethod == 0) {
+                if (const auto payload = jar.rawData(entry)) {
+                    nestedJar = JarArchive::fromMemory(*payload);
+                }
+            } else if (auto content = jar.read(entry)) {
+                nestedJar = JarArchive::fromBuffer(std::move(*content));
+            }
+
+            if (nestedJar) {
+                collectFrom(*nestedJar, classNames, depth + 1);
+            }
+        }
+    }
+}
+
+void ClassIndex::build(std::vector<JarClasses> jars) {
+    clear();
+
+    size_t totalClasses = 0;
+    size_t totalBytes = 0;
+    for (const auto& jar : jars) {
+        totalClasses += jar.classNames.size();
+        for (const auto& name : jar.classNames) {
+            totalBytes += name.size();
+        }
+    }
+
+    arena.reserve(totalBytes);
+    records.reserve(totalClasses);
+    owners.reserve(jars.size());
+
+    for (auto& jar : jars) {
+        const auto owner = static_cast<uint32_t>(owners.size());
+        owners.push_back(std::move(jar.owner));
+
+        for (const auto& name : jar.classNames) {
+            records.push_back({static_cast<uint32_t>(arena.size()), static_cast<uint32_t>(name.size()), owner});
+            arena += name;
+        }
+    }
+
+    std::ranges::sort(records, [this](const Record& a, const Record& b) {
+        return nameOf(a) < nameOf(b);
+    });
+
+    // The same class in two JARs can't be attributed by name alone; keep the first
+    const auto duplicates = std::ranges::unique(records, [this](const Record& a, const Record& b) {
+        return nameOf(a) == nameOf(b);
+    });
+    records.erase(duplicates.begin(), duplicates.end());
+    records.shrink_to_fit();
+}
+
+void ClassIndex::clear() {
+    arena.clear();
+    records.clear();
+    owners.clear();
+}
+
+std::optional<std::string> ClassIndex::findOwner(std::string_view className) const {
+    const std::string name = normalize(className);
+
+    const auto it = std::ranges::lower_bound(records, std::string_view(name), {},
+                                             [this](const Record& r) { return nameOf(r); });
+    if (it == records.end() || nameOf(*it) != name) return std::nullopt;
+
+    return owners[it->owner];
+}
+
+std::optional<std::string> ClassIndex::findPackageOwner(std::string_view className) const {
+    std::string prefix = normalize(className);
+
+    for (const std::string_view gamePackage : GAME_PACKAGES) {
+        if (prefix.starts_with(gamePackage)) return std::nullopt;
+    }
+
+    for (size_t slash = prefix.rfind('/'); slash != std::string::npos; slash = prefix.rfind('/')) {
+        prefix.resize(slash + 1);
+        if (std::ranges::count(prefix, '/') < static_cast<long>(MIN_PACKAGE_DEPTH)) break;
+
+        const auto first = std::ranges::lower_bound(records, std::string_view(prefix), {},
+                                                    [this](const Record& r) { return nameOf(r); });
+        if (first != records.end() && nameOf(*first).starts_with(prefix)) {
+            // A shallower package would only be shared more widely, so stop at the first match
+            const auto last = std::find_if(first, records.end(), [&](const Record& r) {
+                return !nameOf(r).starts_with(prefix);
+            });
+            const bool shared = std::any_of(first, last, [&](const Record& r) {
+                return r.owner != first->owner;
+            });
+            if (shared) return std::nullopt;
+            return owners[first->owner];
+        }
+
+        prefix.pop_back();
+    }
+
+    return std::nullopt;
+}
+
+std::string ClassIndex::normalize(std::string_view className) {
+    // Inner classes and lambdas ("Foo$1", "Foo$$Lambda$42") live in the outer class's JAR
+    if (const size_t dollar = className.find('$'); dollar != std::string_view::npos) {
+        className = className.substr(0, dollar);
+    }
+
+    std::string name(className);
+    std::ranges::replace(name, '.', '/');
+    return name;
+}
@@ -0,0 +1,135 @@
+#include "CompressedText.h"
+#include <iostream>
+#include <zlib.h>
+
+namespace {
+
+constexpr char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int base64Value(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+} // namespace
+
+CompressedText CompressedText::compress(std::string_view text) {
+    CompressedText result;
+    if (text.empty()) return result;
+
+    z_stream stream = {};
+    // Metadata is compressed once per changed JAR during a scan; favour speed over ratio
+    if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        std::cerr << "Failed to initialize compression" << std::endl;
+        return result;
+    }
+
+    result.deflated.resize(deflateBound(&stream, static_cast<uLong>(text.size())));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+    stream.avail_in = static_cast<uInt>(text.size());
+    stream.next_out = reinterpret_cast<Bytef*>(result.deflated.data());
+    stream.avail_out = static_cast<uInt>(result.deflated.size());
+
+    const int status = deflate(&stream, Z_FINISH);
+    result.deflated.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    if (status != Z_STREAM_END) {
+        std::cerr << "Compression failed" << std::endl;
+        return {};
+    }
+
+    result.deflated.shrink_to_fit();
+    result.originalSize = static_cast<uint32_t>(text.size());
+    return result;
+}
+
+CompressedText CompressedText::fromDeflated(std::string_view deflated, uint32_t originalSize) {
+    CompressedText result;
+    result.deflated = std::string(deflated);
+    result.originalSize = originalSize;
+    return result;
+}
+
+std::string CompressedText::decompress() const {
+    if (empty()) return {};
+
+    z_stream stream = {};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        std::cerr << "Failed to initialize decompression" << std::endl;
+        return {};
+    }
+
+    std::string text(originalSize, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(deflated.data()));
+    stream.avail_in = static_cast<uInt>(deflated.size());
+    stream.next_out = reinterpret_cast<Bytef*>(text.data());
+    stream.avail_out = originalSize;
+
+    const int status = inflate(&stream, Z_FINISH);
+    const uLong produced = stream.total_out;
+    inflateEnd(&stream);
+
+    if (status != Z_STREAM_END || produced != originalSize) {
+        std::cerr << "Decompression failed" << std::endl;
+        return {};
+    }
+
+    return text;
+}
+
+std::string CompressedText::toBase64() const {
+    std::string encoded;
+    encoded.reserve((deflated.size() + 2) / 3 * 4);
+
+    size_t i = 0;
+    for (; i + 2 < deflated.size(); i += 3) {
+        const uint32_t group = static_cast<uint8_t>(deflated[i]) << 16 |
+                               static_cast<uint8_t>(deflated[i + 1]) << 8 |
+                               static_cast<uint8_t>(deflated[i + 2]);
+        encoded += BASE64_ALPHABET[group >> 18 & 0x3F];
+        encoded += BASE64_ALPHABET[group >> 12 & 0x3F];
+        encoded += BASE64_ALPHABET[group >> 6 & 0x3F];
+        encoded += BASE64_ALPHABET[group & 0x3F];
+    }
+
+    if (const size_t remaining = deflated.size() - i; remaining > 0) {
+        uint32_t group = static_cast<uint8_t>(deflated[i]) << 16;
+        if (remaining == 2) group |= static_cast<uint8_t>(deflated[i + 1]) << 8;
+
+        encoded += BASE64_ALPHABET[group >> 18 & 0x3F];
+        encoded += BASE64_ALPHABET[group >> 12 & 0x3F];
+        encoded += remaining == 2 ? BASE64_ALPHABET[group >> 6 & 0x3F] : '=';
+        encoded += '=';
+    }
+
+    return encoded;
+}
+
+std::optional<CompressedText> CompressedText::fromBase64(std::string_view encoded, uint32_t originalSize) {
+    CompressedText result;
+    result.originalSize = originalSize;
+    result.deflated.reserve(encoded.size() / 4 * 3);
+
+    uint32_t group = 0;
+    int bits = 0;
+    for (const char c : encoded) {
+        if (c == '=') break;
+
+        const int value = base64Value(c);
+        if (value < 0) return std::nullopt;
+
+        group = group << 6 | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            result.deflated += static_cast<char>(group >> bits & 0xFF);
+        }
+    }
+
+    return result;
+}
@@ -1,4 +1,5 @@
 #include "CrashLogParser.h"
+#include "ClassIndex.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -9,7 +10,8 @@
 
 namespace fs = std::filesystem;
 
-std::optional<CrashInfo> CrashLogParser::parseCrashLog(const std::string& logPath) {
+std::optional<CrashInfo> CrashLogParser::parseCrashLog(const std::string& logPath,
+                                                       const ClassIndex* classIndex) {
     std::string content;
 
     if (logPath.ends_with(".gz")) {
@@ -46,10 +48,11 @@ std::optional<CrashInfo> CrashLogParser::parseCrashLog(const std::string& logPat
         content = buffer.str();
     }
 
-    return parseCrashLogContent(content);
+    return parseCrashLogContent(content, classIndex);
 }
 
-std::optional<CrashInfo> CrashLogParser::parseCrashLogContent(const std::string& content) {
+std::optional<CrashInfo> CrashLogParser::parseCrashLogContent(const std::string& content,
+                                                              const ClassIndex* classIndex) {
     CrashInfo info;
 
     info.isMixinError = isMixinCrash(content);
@@ -65,7 +68,7 @@ std::optional<CrashInfo> CrashLogParser::parseCrashLogContent(const std::string&
             inStackTrace = true;
             info.stackTrace.push_back(line);
 
-            if (auto modId = extractModIdFromStackTrace(line)) {
+            if (auto modId = extractModIdFromStackTrace(line, classIndex)) {
                 if (std::ranges::find(info.suspectedMods, *modId)
                     == info.suspectedMods.end()) {
                     info.suspectedMods.push_back(*modId);
@@ -151,7 +154,21 @@ std::optional<std::string> CrashLogParser::findLatestCrashLog(const std::string&
     return std::nullopt;
 }
 
-std::optional<std::string> CrashLogParser::extractModIdFromStackTrace(const std::string& line) {
+std::optional<std::string> CrashLogParser::extractModIdFromStackTrace(const std::string& line,
+                                                                       const ClassIndex* classIndex) {
+    const bool useIndex = classIndex && !classIndex->empty();
+
+    if (useIndex) {
+        if (const auto className = extractFrameClass(line)) {
+            if (auto owner = classIndex->findOwner(*className)) {
+                return owner;
+            }
+            if (auto owner = classIndex->findPackageOwner(*className)) {
+                return owner;
+            }
+        }
+    }
+
     const std::regex mixinPattern(R"(([a-z0-9_-]+)\$[a-zA-Z0-9_]+)");
     std::smatch match;
 
@@ -159,6 +176,12 @@ std::optional<std::string> CrashLogParser::extractModIdFromStackTrace(const std:
         return match[1].str();
     }
 
+    // The index covers every scanned JAR, so a class outside every mod's packages belongs
+    // to Minecraft, the loader or the JDK; guessing from the package name only misleads
+    if (useIndex) {
+        return std::nullopt;
+    }
+
     if (const std::regex packagePattern(R"((?:net|com|org)\.(?:fabricmc|modded|minecraft|[a-z0-9_]+)\.([a-z0-9_-]+))"); std::regex_search(line, match, packagePattern)) {
         if (std::string potentialModId = match[1].str(); potentialModId != "minecraft" &&
                                                          potentialModId != "loader" &&
@@ -172,6 +195,28 @@ std::optional<std::string> CrashLogParser::extractModIdFromStackTrace(const std:
     return std::nullopt;
 }
 
+std::optional<std::string> CrashLogParser::extractFrameClass(const std::string& line) {
+    // "\tat knot//net.example.Foo$Bar.method(Foo.java:12) ~[example.jar:?]"
+    const size_t atPos = line.find("at ");
+    if (atPos == std::string::npos) return std::nullopt;
+
+    const size_t start = atPos + 3;
+    const size_t paren = line.find('(', start);
+    if (paren == std::string::npos) return std::nullopt;
+
+    std::string frame = line.substr(start, paren - start);
+
+    // Strip class loader / module prefixes such as "knot//" or "TRANSFORMER/minecraft@1.20.1/"
+    if (const size_t slash = frame.rfind('/'); slash != std::string::npos) {
+        frame = frame.substr(slash + 1);
+    }
+
+    const size_t methodDot = frame.rfind('.');
+    if (methodDot == std::string::npos || methodDot == 0) return std::nullopt;
+
+    return frame.substr(0, methodDot);
+}
+
 bool CrashLogParser::isMixinCrash(const std::string& content) {
     return content.find("Mixin") != std::string::npos ||
            content.find("mixin") != std::string::npos ||
@@ -0,0 +1,167 @@
+#include "DependencyGraph.h"
+#include <algorithm>
+
+void DependencyGraph::build(const ModTable& table) {
+    clear();
+
+    start.reserve(table.size() + 1);
+    start.push_back(0);
+
+    std::vector<ModHandle> row;
+    for (ModHandle handle = 0; handle < table.size(); ++handle) {
+        row.clear();
+        for (const ModTable::Symbol symbol : table.dependencies(handle)) {
+            if (const auto provider = table.providerOf(symbol); provider && *provider != handle) {
+                row.push_back(*provider);
+            }
+        }
+
+        // Several IDs can resolve to the same JAR
+        std::ranges::sort(row);
+        const auto duplicates = std::ranges::unique(row);
+        targets.insert(targets.end(), row.begin(), duplicates.begin());
+        start.push_back(static_cast<uint32_t>(targets.size()));
+    }
+
+    // Reverse edges: count per target, prefix sums, then fill. Sources are visited in
+    // increasing order, so each row comes out sorted.
+    reverseStart.assign(table.size() + 1, 0);
+    for (const ModHandle target : targets) {
+        reverseStart[target + 1]++;
+    }
+    for (size_t i = 1; i < reverseStart.size(); ++i) {
+        reverseStart[i] += reverseStart[i - 1];
+    }
+
+    reverseTargets.resize(targets.size());
+    std::vector<uint32_t> fill(reverseStart.begin(), reverseStart.end() - 1);
+    for (ModHandle source = 0; source < table.size(); ++source) {
+        for (const ModHandle target : dependencies(source)) {
+            reverseTargets[fill[target]++] = source;
+        }
+    }
+
+    component.assign(table.size(), 0);
+    findComponents();
+}
+
+void DependencyGraph::clear() {
+    start.clear();
+    targets.clear();
+    reverseStart.clear();
+    reverseTargets.clear();
+    component.clear();
+    componentClosures.clear();
+}
+
+ModBitset DependencyGraph::closureOf(const ModBitset& roots) const {
+    ModBitset result(size());
+
+    roots.forEach([&](ModHandle handle) {
+        // Already reached from an earlier root, so its closure is in there too
+        if (result.test(handle)) return;
+        result |= componentClosures[component[handle]];
+    });
+
+    return result;
+}
+
+ModBitset DependencyGraph::dependentClosureOf(const ModBitset& roots) const {
+    ModBitset result = roots;
+
+    std::vector<ModHandle> pending;
+    roots.forEach([&](ModHandle handle) { pending.push_back(handle); });
+
+    while (!pending.empty()) {
+        const ModHandle handle = pending.back();
+        pending.pop_back();
+
+        for (const ModHandle dependent : dependents(handle)) {
+            if (!result.test(dependent)) {
+                result.set(dependent);
+                pending.push_back(dependent);
+            }
+        }
+    }
+
+    return result;
+}
+
+void DependencyGraph::findComponents() {
+    // Tarjan's algorithm with an explicit stack; large packs have long dependency chains
+    constexpr uint32_t UNVISITED = UINT32_MAX;
+
+    struct Frame {
+        ModHandle node;
+        uint32_t nextEdge;
+    };
+
+    const size_t nodeCount = size();
+    std::vector<uint32_t> index(nodeCount, UNVISITED);
+    std::vector<uint32_t> lowLink(nodeCount, 0);
+    std::vector<bool> onStack(nodeCount, false);
+    std::vector<ModHandle> stack;
+    std::vector<Frame> callStack;
+    std::vector<ModHandle> members;
+    uint32_t nextIndex = 0;
+
+    const auto visit = [&](ModHandle node) {
+        index[node] = lowLink[node] = nextIndex++;
+        stack.push_back(node);
+        onStack[node] = true;
+        callStack.push_back({node, start[node]});
+    };
+
+    for (ModHandle root = 0; root < nodeCount; ++root) {
+        if (index[root] != UNVISITED) continue;
+        visit(root);
+
+        while (!callStack.empty()) {
+            const ModHandle node = callStack.back().node;
+
+            if (uint32_t& edge = callStack.back().nextEdge; edge < start[node + 1]) {
+                const ModHandle next = targets[edge++];
+                if (index[next] == UNVISITED) {
+                    visit(next);
+                } else if (onStack[next]) {
+                    lowLink[node] = std::min(lowLink[node], index[next]);
+                }
+                continue;
+            }
+
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                const ModHandle parent = callStack.back().node;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+            }
+
+            if (lowLink[node] != index[node]) continue;
+
+            // node roots a component; everything it needs outside it is numbered already
+            const auto componentIndex = static_cast<uint32_t>(componentClosures.size());
+            ModBitset closure(nodeCount);
+
+            members.clear();
+            ModHandle member;
+            do {
+                member = stack.back();
+                stack.pop_back();
+                onStack[member] = false;
+                component[member] = componentIndex;
+                closure.set(member);
+                members.push_back(member);
+            } while (member != node);
+
+            for (const ModHandle m : members) {
+                for (const ModHandle dependency : dependencies(m)) {
+                    // Members are set already; so is anything in a closure merged before
+                    if (!closure.test(dependency)) {
+                        closure |= componentClosures[component[dependency]];
+                    }
+                }
+            }
+
+            componentClosures.push_back(std::move(closure));
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#include "DirectoryRenamer.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <cerrno>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #include <cstdio>
+#endif
+
+#ifdef __linux__
+    #include <sys/syscall.h>
+    #ifndef RENAME_NOREPLACE
+        #define RENAME_NOREPLACE (1 << 0)
+    #endif
+#endif
+
+DirectoryRenamer::DirectoryRenamer(const fs::path& directory)
+    : directory(directory) {
+#ifndef _WIN32
+    dirFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+#endif
+}
+
+DirectoryRenamer::~DirectoryRenamer() {
+#ifndef _WIN32
+    if (dirFd >= 0) {
+        ::close(dirFd);
+    }
+#endif
+}
+
+bool DirectoryRenamer::isOpen() const {
+#ifdef _WIN32
+    return true;
+#else
+    return dirFd >= 0;
+#endif
+}
+
+bool DirectoryRenamer::renameAll(std::vector<Rename>& renames, unsigned threads) {
+    if (!isOpen()) {
+        for (auto& rename : renames) {
+            rename.error = std::make_error_code(std::errc::bad_file_descriptor);
+        }
+        return renames.empty();
+    }
+
+    parallelFor(renames.size(), threads, [&](size_t i) {
+        renames[i].error = renameOne(renames[i].from, renames[i].to);
+    });
+
+    return std::ranges::none_of(renames, [](const Rename& rename) { return static_cast<bool>(rename.error); });
+}
+
+std::error_code DirectoryRenamer::renameOne(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    std::error_code ec;
+    if (fs::exists(directory / to, ec)) return std::make_error_code(std::errc::file_exists);
+    fs::rename(directory / from, directory / to, ec);
+    return ec;
+#else
+    #ifdef SYS_renameat2
+    if (!noReplaceUnsupported.load(std::memory_order_relaxed)) {
+        if (::syscall(SYS_renameat2, dirFd, from.c_str(), dirFd, to.c_str(), RENAME_NOREPLACE) == 0) return {};
+        if (errno != EINVAL && errno != ENOSYS) return {errno, std::generic_category()};
+
+        // NFS and a few other filesystems (or a pre-3.15 kernel) reject the flag
+        noReplaceUnsupported.store(true, std::memory_order_relaxed);
+    }
+    #endif
+
+    struct stat existing {};
+    if (::fstatat(dirFd, to.c_str(), &existing, AT_SYMLINK_NOFOLLOW) == 0) {
+        return std::make_error_code(std::errc::file_exists);
+    }
+    if (::renameat(dirFd, from.c_str(), dirFd, to.c_str()) != 0) {
+        return {errno, std::generic_category()};
+    }
+    return {};
+#endif
+}
@@ -1,11 +1,28 @@
 #include "JarReader.h"
+#include "UringReader.h"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <cstring>
 #include <cstdint>
-#include <vector>
+#include <unordered_set>
 #include <zlib.h>
 
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 // ZIP file format structures
 #if defined(__GNUC__) || defined(__clang__)
     #define PACKED __attribute__((packed))
@@ -64,101 +81,651 @@ struct ZipEndOfCentralDir {
 #endif
 #undef PACKED
 
-std::optional<std::string> JarReader::extractFabricModJson(const std::string& jarPath) {
-    return readFileFromZip(jarPath, "fabric.mod.json");
+namespace {
+
+constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr uint32_t CENTRAL_DIR_SIGNATURE = 0x02014b50;
+constexpr uint32_t END_OF_CENTRAL_DIR_SIGNATURE = 0x06054b50;
+constexpr size_t MAX_ZIP_COMMENT = 0xFFFF;
+
+// First read of each file in JarArchive::openAll(); holds the end-of-directory record
+// and, for most mods, the whole central directory
+constexpr uint64_t TAIL_READ_SIZE = 16 * 1024;
+
+// A local header's extra field can differ from the central directory's copy. Prefetches
+// read this much beyond the name; a larger field just means the entry is read from the mapping.
+constexpr uint64_t LOCAL_EXTRA_ALLOWANCE = 256;
+
+// The archive bytes have no alignment guarantees, so headers are copied out rather than cast.
+template <typename T>
+bool readStruct(std::string_view data, size_t offset, T& out) {
+    if (offset > data.size() || data.size() - offset < sizeof(T)) return false;
+    std::memcpy(&out, data.data() + offset, sizeof(T));
+    return true;
 }
 
-bool JarReader::isValidJar(const std::string& jarPath) {
-    std::ifstream file(jarPath, std::ios::binary);
-    if (!file.is_open()) return false;
+std::optional<size_t> findEndOfCentralDir(std::string_view data) {
+    if (data.size() < sizeof(ZipEndOfCentralDir)) return std::nullopt;
 
-    uint32_t signature;
-    file.read(reinterpret_cast<char*>(&signature), sizeof(signature));
+    // The record is normally the last 22 bytes, but may be followed by an archive comment
+    const size_t last = data.size() - sizeof(ZipEndOfCentralDir);
+    const size_t first = last > MAX_ZIP_COMMENT ? last - MAX_ZIP_COMMENT : 0;
 
-    // Check for ZIP signature (0x04034b50 = PK\x03\x04)
-    return signature == 0x04034b50;
+    for (size_t pos = last + 1; pos-- > first;) {
+        uint32_t signature;
+        std::memcpy(&signature, data.data() + pos, sizeof(signature));
+        if (signature == END_OF_CENTRAL_DIR_SIGNATURE) return pos;
+    }
+
+    return std::nullopt;
 }
 
-std::optional<std::string> JarReader::readFileFromZip(const std::string& zipPath,
-                                                       const std::string& filename) {
-    std::ifstream file(zipPath, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Could not open JAR file: " << zipPath << std::endl;
-        return std::nullopt;
+} // namespace
+
+// Read-only view of a whole file. The mapping lives as long as this object.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                 nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) return;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) return;
+
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mappingHandle) return;
+
+        void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (!view) return;
+
+        bytes = static_cast<const char*>(view);
+        length = static_cast<size_t>(fileSize.QuadPart);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+
+        struct stat st {};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                bytes = static_cast<const char*>(view);
+                length = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+#endif
     }
 
-    // Find end of central directory
-    file.seekg(-static_cast<int>(sizeof(ZipEndOfCentralDir)), std::ios::end);
-    ZipEndOfCentralDir endDir{};
-    file.read(reinterpret_cast<char*>(&endDir), sizeof(endDir));
+    ~MappedFile() {
+#ifdef _WIN32
+        if (bytes) UnmapViewOfFile(bytes);
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+#else
+        if (bytes) ::munmap(const_cast<char*>(bytes), length);
+#endif
+    }
 
-    if (endDir.signature != 0x06054b50) {
-        std::cerr << "Invalid ZIP file: " << zipPath << std::endl;
-        return std::nullopt;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] bool isOpen() const { return bytes != nullptr; }
+    [[nodiscard]] std::string_view view() const { return {bytes, length}; }
+
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE mappingHandle = nullptr;
+#endif
+};
+
+// An archive read in pieces by JarArchive::openAll(): the byte ranges fetched so far and the
+// descriptor for later batches. Anything outside them is read through a mapping of the whole
+// file, created on first use.
+class SparseFile {
+public:
+    SparseFile(std::string path, int fd, uint64_t size)
+        : path(std::move(path)), fd(fd), fileSize(size) {}
+
+    ~SparseFile() {
+#ifndef _WIN32
+        if (fd >= 0) ::close(fd);
+#endif
     }
 
-    // Read central directory entries
-    file.seekg(endDir.centralDirOffset, std::ios::beg);
+    SparseFile(const SparseFile&) = delete;
+    SparseFile& operator=(const SparseFile&) = delete;
 
-    for (uint16_t i = 0; i < endDir.numEntries; ++i) {
-        ZipCentralDirEntry entry{};
-        file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+    [[nodiscard]] uint64_t size() const { return fileSize; }
 
-        if (entry.signature != 0x02014b50) {
-            std::cerr << "Invalid central directory entry" << std::endl;
+    [[nodiscard]] bool contains(uint64_t offset, size_t length) const {
+        return std::ranges::any_of(segments, [&](const Segment& segment) {
+            return offset >= segment.offset && offset - segment.offset <= segment.bytes->size() &&
+                   segment.bytes->size() - (offset - segment.offset) >= length;
+        });
+    }
+
+    // Adds a segment for [offset, offset + length) and returns the read that fills it
+    ReadRequest reserve(uint64_t offset, size_t length) {
+        auto& bytes = segments.emplace_back(offset, std::make_unique<std::string>(length, '\0')).bytes;
+
+        ReadRequest request;
+        request.fd = fd;
+        request.offset = offset;
+        request.buffer = bytes->data();
+        request.length = static_cast<uint32_t>(length);
+        return request;
+    }
+
+    // Trims the segment filled by a completed read to what was actually read
+    void commit(const ReadRequest& request) {
+        const auto it = std::ranges::find_if(segments, [&](const Segment& segment) {
+            return segment.bytes->data() == request.buffer;
+        });
+        if (it == segments.end()) return;
+
+        if (request.result <= 0) {
+            segments.erase(it);
+        } else {
+            it->bytes->resize(static_cast<size_t>(request.result));
+        }
+    }
+
+    std::optional<std::string_view> view(uint64_t offset, size_t length) {
+        for (const auto& segment : segments) {
+            const std::string_view bytes = *segment.bytes;
+            if (offset >= segment.offset && offset - segment.offset <= bytes.size() &&
+                bytes.size() - (offset - segment.offset) >= length) {
+                return bytes.substr(offset - segment.offset, length);
+            }
+        }
+
+        if (!mapping) {
+            mapping = std::make_unique<MappedFile>(path);
+        }
+        if (!mapping->isOpen()) return std::nullopt;
+
+        const std::string_view whole = mapping->view();
+        if (offset > whole.size() || whole.size() - offset < length) return std::nullopt;
+        return whole.substr(offset, length);
+    }
+
+private:
+    // Heap-allocated so views into a segment survive later reserve() calls
+    struct Segment {
+        uint64_t offset = 0;
+        std::unique_ptr<std::string> bytes;
+    };
+
+    std::string path;
+    int fd = -1;
+    uint64_t fileSize = 0;
+    std::vector<Segment> segments;
+    std::unique_ptr<MappedFile> mapping;
+};
+
+// Raw-deflate stream reused for every entry of an archive; reset between entries
+class Inflater {
+public:
+    Inflater() = default;
+
+    ~Inflater() {
+        if (initialized) inflateEnd(&stream);
+    }
+
+    Inflater(const Inflater&) = delete;
+    Inflater& operator=(const Inflater&) = delete;
+
+    std::optional<std::string> inflateEntry(std::string_view payload, uint32_t uncompressedSize) {
+        if (!initialized) {
+            if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+                std::cerr << "Failed to initialize decompression" << std::endl;
+                return std::nullopt;
+            }
+            initialized = true;
+        } else {
+            inflateReset(&stream);
+        }
+
+        std::string uncompressedData(uncompressedSize, '\0');
+
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(payload.data()));
+        stream.avail_in = static_cast<uInt>(payload.size());
+        stream.next_out = reinterpret_cast<Bytef*>(uncompressedData.data());
+        stream.avail_out = uncompressedSize;
+
+        if (inflate(&stream, Z_FINISH) != Z_STREAM_END) {
+            std::cerr << "Decompression failed" << std::endl;
             return std::nullopt;
         }
 
-        std::vector<char> filenameBuf(entry.filenameLength + 1, 0);
-        file.read(filenameBuf.data(), entry.filenameLength);
-        std::string entryName(filenameBuf.data());
+        return uncompressedData;
+    }
+
+private:
+    z_stream stream = {};
+    bool initialized = false;
+};
+
+JarArchive::JarArchive() : inflater(std::make_unique<Inflater>()) {}
+
+JarArchive::JarArchive(JarArchive&&) noexcept = default;
+JarArchive& JarArchive::operator=(JarArchive&&) noexcept = default;
+JarArchive::~JarArchive() = default;
+
+std::optional<JarArchive> JarArchive::open(const std::string& jarPath) {
+    JarArchive archive;
+    archive.mapping = std::make_unique<MappedFile>(jarPath);
+    if (!archive.mapping->isOpen()) {
+        std::cerr << "Could not open JAR file: " << jarPath << std::endl;
+        return std::nullopt;
+    }
+
+    archive.data = archive.mapping->view();
+    if (!archive.parseCentralDirectory()) return std::nullopt;
+
+    return archive;
+}
+
+std::optional<JarArchive> JarArchive::fromMemory(std::string_view data) {
+    JarArchive archive;
+    archive.data = data;
+    if (!archive.parseCentralDirectory()) return std::nullopt;
+
+    return archive;
+}
+
+std::optional<JarArchive> JarArchive::fromBuffer(std::string data) {
+    JarArchive archive;
+    archive.ownedData = std::make_unique<std::string>(std::move(data));
+    archive.data = *archive.ownedData;
+    if (!archive.parseCentralDirectory()) return std::nullopt;
+
+    return archive;
+}
+
+std::vector<std::optional<JarArchive>> JarArchive::openAll(const std::vector<std::string>& jarPaths) {
+    std::vector<std::optional<JarArchive>> archives(jarPaths.size());
+
+#ifndef _WIN32
+    if (UringReader::isSupported()) {
+        UringReader reader;
+        std::vector<std::unique_ptr<SparseFile>> files(jarPaths.size());
+        std::vector<ReadRequest> reads;
+        std::vector<size_t> readOwners;
+
+        // Pass 1: the tail of every file
+        for (size_t i = 0; i < jarPaths.size(); ++i) {
+            const int fd = ::open(jarPaths[i].c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                std::cerr << "Could not open JAR file: " << jarPaths[i] << std::endl;
+                continue;
+            }
+
+            struct stat st {};
+            if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+                ::close(fd);
+                std::cerr << "Could not open JAR file: " << jarPaths[i] << std::endl;
+                continue;
+            }
+
+            const auto fileSize = static_cast<uint64_t>(st.st_size);
+            const uint64_t tailLength = std::min(fileSize, TAIL_READ_SIZE);
+            files[i] = std::make_unique<SparseFile>(jarPaths[i], fd, fileSize);
+            reads.push_back(files[i]->reserve(fileSize - tailLength, tailLength));
+            readOwners.push_back(i);
+        }
+
+        reader.readAll(reads);
+        for (size_t k = 0; k < reads.size(); ++k) {
+            files[readOwners[k]]->commit(reads[k]);
+        }
 
-        file.seekg(entry.extraFieldLength + entry.commentLength, std::ios::cur);
+        // Pass 2: central directories that start before the tail
+        std::vector<ZipEndOfCentralDir> endDirs(jarPaths.size());
+        reads.clear();
+        readOwners.clear();
 
-        if (entryName == filename) {
-            auto currentPos = file.tellg();
-            file.seekg(entry.localHeaderOffset, std::ios::beg);
+        for (size_t i = 0; i < jarPaths.size(); ++i) {
+            if (!files[i]) continue;
 
-            ZipLocalFileHeader localHeader{};
-            file.read(reinterpret_cast<char*>(&localHeader), sizeof(localHeader));
+            const uint64_t tailLength = std::min(files[i]->size(), TAIL_READ_SIZE);
+            const auto tail = files[i]->view(files[i]->size() - tailLength, tailLength);
+            const auto endDirPos = tail ? findEndOfCentralDir(*tail) : std::nullopt;
+            if (!endDirPos) {
+                // Not a ZIP, or an archive comment longer than the tail; the mapped path sorts it out
+                files[i].reset();
+                archives[i] = open(jarPaths[i]);
+                continue;
+            }
 
-            file.seekg(localHeader.filenameLength + localHeader.extraFieldLength, std::ios::cur);
+            ZipEndOfCentralDir& endDir = endDirs[i];
+            readStruct(*tail, *endDirPos, endDir);
 
-            std::vector<char> compressedData(entry.compressedSize);
-            file.read(compressedData.data(), entry.compressedSize);
+            if (endDir.centralDirOffset > files[i]->size() ||
+                files[i]->size() - endDir.centralDirOffset < endDir.centralDirSize) {
+                std::cerr << "Invalid ZIP file: central directory out of bounds: " << jarPaths[i] << std::endl;
+                files[i].reset();
+                continue;
+            }
 
-            if (entry.compressionMethod == 0) {
-                return std::string(compressedData.begin(), compressedData.end());
+            if (!files[i]->contains(endDir.centralDirOffset, endDir.centralDirSize)) {
+                reads.push_back(files[i]->reserve(endDir.centralDirOffset, endDir.centralDirSize));
+                readOwners.push_back(i);
             }
+        }
 
-            if (entry.compressionMethod == 8) {
-                std::vector<char> uncompressedData(entry.uncompressedSize);
+        reader.readAll(reads);
+        for (size_t k = 0; k < reads.size(); ++k) {
+            files[readOwners[k]]->commit(reads[k]);
+        }
 
-                z_stream stream = {};
-                stream.next_in = reinterpret_cast<Bytef*>(compressedData.data());
-                stream.avail_in = entry.compressedSize;
-                stream.next_out = reinterpret_cast<Bytef*>(uncompressedData.data());
-                stream.avail_out = entry.uncompressedSize;
+        for (size_t i = 0; i < jarPaths.size(); ++i) {
+            if (!files[i]) continue;
 
-                if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
-                    std::cerr << "Failed to initialize decompression" << std::endl;
-                    return std::nullopt;
-                }
+            const ZipEndOfCentralDir& endDir = endDirs[i];
+            const auto directory = files[i]->view(endDir.centralDirOffset, endDir.centralDirSize);
+            if (!directory) continue;
+
+            JarArchive archive;
+            archive.sparse = std::move(files[i]);
+            if (archive.indexCentralDirectory(*directory, endDir.numEntries)) {
+                archives[i] = std::move(archive);
+            }
+        }
+
+        return archives;
+    }
+#endif
+
+    for (size_t i = 0; i < jarPaths.size(); ++i) {
+        archives[i] = open(jarPaths[i]);
+    }
+    return archives;
+}
+
+void JarArchive::prefetch(const std::vector<std::pair<JarArchive*, const JarEntry*>>& entries) {
+    std::vector<ReadRequest> reads;
+    std::vector<SparseFile*> readOwners;
+
+    for (const auto& [archive, entry] : entries) {
+        if (!archive->sparse) continue;
 
-                int result = inflate(&stream, Z_FINISH);
-                inflateEnd(&stream);
+        SparseFile& file = *archive->sparse;
+        const uint64_t offset = entry->localHeaderOffset;
+        if (offset >= file.size()) continue;
 
-                if (result != Z_STREAM_END) {
-                    std::cerr << "Decompression failed" << std::endl;
-                    return std::nullopt;
+        const uint64_t wanted = sizeof(ZipLocalFileHeader) + entry->name.size() +
+                                LOCAL_EXTRA_ALLOWANCE + entry->compressedSize;
+        const uint64_t length = std::min(wanted, file.size() - offset);
+        if (file.contains(offset, length)) continue;
+
+        reads.push_back(file.reserve(offset, length));
+        readOwners.push_back(&file);
+    }
+
+    if (reads.empty()) return;
+
+    UringReader reader;
+    reader.readAll(reads);
+    for (size_t k = 0; k < reads.size(); ++k) {
+        readOwners[k]->commit(reads[k]);
+    }
+}
+
+bool JarArchive::parseCentralDirectory() {
+    const auto endDirPos = findEndOfCentralDir(data);
+    if (!endDirPos) {
+        std::cerr << "Invalid ZIP file: missing end of central directory" << std::endl;
+        return false;
+    }
+
+    ZipEndOfCentralDir endDir{};
+    readStruct(data, *endDirPos, endDir);
+
+    const size_t directoryOffset = std::min<size_t>(endDir.centralDirOffset, data.size());
+    return indexCentralDirectory(data.substr(directoryOffset), endDir.numEntries);
+}
+
+bool JarArchive::indexCentralDirectory(std::string_view directory, uint16_t numEntries) {
+    entryList.reserve(numEntries);
+    index.reserve(numEntries);
+
+    size_t pos = 0;
+
+    for (uint16_t i = 0; i < numEntries; ++i) {
+        ZipCentralDirEntry header{};
+        if (!readStruct(directory, pos, header) || header.signature != CENTRAL_DIR_SIGNATURE) {
+            std::cerr << "Invalid central directory entry" << std::endl;
+            return false;
+        }
+
+        const size_t namePos = pos + sizeof(header);
+        if (directory.size() - namePos < header.filenameLength) {
+            std::cerr << "Truncated central directory" << std::endl;
+            return false;
+        }
+
+        JarEntry entry;
+        entry.name = directory.substr(namePos, header.filenameLength);
+        entry.crc32 = header.crc32;
+        entry.compressedSize = header.compressedSize;
+        entry.uncompressedSize = header.uncompressedSize;
+        entry.localHeaderOffset = header.localHeaderOffset;
+        entry.compressionMethod = header.compressionMethod;
+
+        index.try_emplace(entry.name, entryList.size());
+        entryList.push_back(entry);
+
+        pos = namePos + header.filenameLength + header.extraFieldLength + header.commentLength;
+    }
+
+    return true;
+}
+
+std::optional<std::string_view> JarArchive::span(uint64_t offset, size_t length) const {
+    if (sparse) return sparse->view(offset, length);
+
+    if (offset > data.size() || data.size() - offset < length) return std::nullopt;
+    return data.substr(offset, length);
+}
+
+const JarEntry* JarArchive::find(std::string_view name) const {
+    const auto it = index.find(name);
+    return it != index.end() ? &entryList[it->second] : nullptr;
+}
+
+std::vector<const JarEntry*> JarArchive::findMatching(std::string_view pattern) const {
+    std::vector<const JarEntry*> matches;
+    for (const auto& entry : entryList) {
+        if (JarReader::matchesGlob(pattern, entry.name)) {
+            matches.push_back(&entry);
+        }
+    }
+    return matches;
+}
+
+std::optional<std::string_view> JarArchive::rawData(const JarEntry& entry) const {
+    ZipLocalFileHeader localHeader{};
+    const auto headerBytes = span(entry.localHeaderOffset, sizeof(localHeader));
+    if (!headerBytes || !readStruct(*headerBytes, 0, localHeader) ||
+        localHeader.signature != LOCAL_HEADER_SIGNATURE) {
+        std::cerr << "Invalid local file header" << std::endl;
+        return std::nullopt;
+    }
+
+    const uint64_t dataPos = static_cast<uint64_t>(entry.localHeaderOffset) + sizeof(localHeader) +
+                             localHeader.filenameLength + localHeader.extraFieldLength;
+    const auto payload = span(dataPos, entry.compressedSize);
+    if (!payload) {
+        std::cerr << "Truncated ZIP entry: " << entry.name << std::endl;
+        return std::nullopt;
+    }
+
+    return payload;
+}
+
+std::optional<std::string> JarArchive::read(const JarEntry& entry) const {
+    const auto payload = rawData(entry);
+    if (!payload) return std::nullopt;
+
+    if (entry.compressionMethod == 0) {
+        return std::string(*payload);
+    }
+
+    if (entry.compressionMethod != 8) {
+        std::cerr << "Unsupported compression method: " << entry.compressionMethod << std::endl;
+        return std::nullopt;
+    }
+
+    return inflater->inflateEntry(*payload, entry.uncompressedSize);
+}
+
+std::optional<std::string> JarArchive::read(std::string_view name) const {
+    const JarEntry* entry = find(name);
+    if (!entry) return std::nullopt;
+
+    return read(*entry);
+}
+
+std::unordered_map<std::string, std::string> JarArchive::extract(
+    const std::vector<std::string>& names,
+    const std::vector<std::string>& patterns) const {
+
+    std::unordered_map<std::string, std::string> result;
+    std::unordered_set<const JarEntry*> wanted;
+
+    for (const auto& name : names) {
+        if (const JarEntry* entry = find(name)) {
+            wanted.insert(entry);
+        }
+    }
+
+    if (!patterns.empty()) {
+        for (const auto& entry : entryList) {
+            for (const auto& pattern : patterns) {
+                if (JarReader::matchesGlob(pattern, entry.name)) {
+                    wanted.insert(&entry);
+                    break;
                 }
+            }
+        }
+    }
+
+    // Inflate in archive order so reads walk the file front to back
+    for (const auto& entry : entryList) {
+        if (!wanted.contains(&entry)) continue;
+
+        if (auto content = read(entry)) {
+            result.emplace(std::string(entry.name), std::move(*content));
+        }
+    }
+
+    return result;
+}
+
+std::optional<std::string> JarReader::extractFabricModJson(const std::string& jarPath,
+                                                           uint32_t* entryCrc) {
+    const auto jar = JarArchive::open(jarPath);
+    if (!jar) return std::nullopt;
+
+    const JarEntry* entry = jar->find("fabric.mod.json");
+    if (!entry) return std::nullopt;
+
+    if (entryCrc) {
+        *entryCrc = entry->crc32;
+    }
+
+    return jar->read(*entry);
+}
+
+bool JarReader::isValidJar(const std::string& jarPath) {
+    std::ifstream file(jarPath, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    uint32_t signature;
+    file.read(reinterpret_cast<char*>(&signature), sizeof(signature));
 
-                return std::string(uncompressedData.begin(), uncompressedData.end());
+    // Check for ZIP signature (0x04034b50 = PK\x03\x04)
+    return signature == LOCAL_HEADER_SIGNATURE;
+}
+
+std::optional<uint32_t> JarReader::getEntryCrc32(const std::string& zipPath, std::string_view filename) {
+    const auto jar = JarArchive::open(zipPath);
+    if (!jar) return std::nullopt;
+
+    const JarEntry* entry = jar->find(filename);
+    if (!entry) return std::nullopt;
+
+    return entry->crc32;
+}
+
+void JarReader::visitNestedJars(const JarArchive& jar, const std::vector<std::string>& entries,
+                                const NestedJarVisitor& visitor) {
+    visitNestedJars(jar, entries, visitor, 0);
+}
+
+void JarReader::visitNestedJars(const JarArchive& jar, const std::vector<std::string>& entries,
+                                const NestedJarVisitor& visitor, int depth) {
+    if (depth >= MAX_NESTING_DEPTH) {
+        std::cerr << "Nested JARs exceed maximum depth of " << MAX_NESTING_DEPTH << std::endl;
+        return;
+    }
+
+    for (const auto& entryPath : entries) {
+        const JarEntry* entry = jar.find(entryPath);
+        if (!entry) {
+            std::cerr << "Nested JAR not found: " << entryPath << std::endl;
+            continue;
+        }
+
+        // Nested JARs are normally stored uncompressed and are opened in place;
+        // deflated ones are inflated into a buffer owned by the nested archive
+        std::optional<JarArchive> nestedJar;
+        if (entry->compressionMethod == 0) {
+            if (const auto payload = jar.rawData(*entry)) {
+                nestedJar = JarArchive::fromMemory(*payload);
             }
+        } else if (auto content = jar.read(*entry)) {
+            nestedJar = JarArchive::fromBuffer(std::move(*content));
+        }
+        if (!nestedJar) continue;
 
-            file.seekg(currentPos, std::ios::beg);
+        const auto modJson = nestedJar->read("fabric.mod.json");
+        if (!modJson) continue;
+
+        const auto innerEntries = visitor(entryPath, *modJson);
+        visitNestedJars(*nestedJar, innerEntries, visitor, depth + 1);
+    }
+}
+
+bool JarReader::matchesGlob(std::string_view pattern, std::string_view name) {
+    if (pattern.empty()) return name.empty();
+
+    if (pattern.starts_with("**")) {
+        for (size_t i = 0; i <= name.size(); ++i) {
+            if (matchesGlob(pattern.substr(2), name.substr(i))) return true;
         }
+        return false;
     }
 
-    return std::nullopt;
-}
\ No newline at end of file
+    if (pattern[0] == '*') {
+        for (size_t i = 0; i <= name.size(); ++i) {
+            if (matchesGlob(pattern.substr(1), name.substr(i))) return true;
+            if (i < name.size() && name[i] == '/') break;
+        }
+        return false;
+    }
+
+    if (name.empty()) return false;
+
+    if (pattern[0] == '?' ? name[0] != '/' : pattern[0] == name[0]) {
+        return matchesGlob(pattern.substr(1), name.substr(1));
+    }
+
+    return false;
+}
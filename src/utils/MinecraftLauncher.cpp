@@ -8,7 +8,7 @@
 using json = nlohmann::json;
 
 MinecraftLauncher::MinecraftLauncher(const std::string& instancePath)
-    : instancePath(instancePath) {
+    : instancePath(instancePath), gameDirectory(instancePath) {
 
     modsPath = fs::path(instancePath) / "mods";
     versionsPath = fs::path(instancePath) / "versions";
@@ -20,6 +20,11 @@ bool MinecraftLauncher::canLaunch() const {
     return fs::exists(versionsPath) && fs::exists(librariesPath);
 }
 
+bool MinecraftLauncher::canLaunchGameDirectory() const {
+    const std::string customCommand = Config::getInstance().getLaunchCommand();
+    return customCommand.empty() || customCommand.find("{gameDir}") != std::string::npos;
+}
+
 std::string MinecraftLauncher::findJava() const {
     const char* javaHome = std::getenv("JAVA_HOME");
     if (javaHome) {
@@ -253,7 +258,7 @@ std::vector<std::string> MinecraftLauncher::getGameArgs(const std::string& versi
     std::vector<std::string> args;
 
     args.emplace_back("--gameDir");
-    args.push_back(instancePath.string());
+    args.push_back(gameDirectory.string());
 
     args.emplace_back("--assetsDir");
     args.push_back(assetsPath.string());
@@ -281,6 +286,18 @@ bool MinecraftLauncher::launch() const {
 
     std::string customCommand = Config::getInstance().getLaunchCommand();
     if (!customCommand.empty()) {
+        if (gameDirectory != instancePath && !canLaunchGameDirectory()) {
+            std::cerr << "The custom launch command has no {gameDir} placeholder, so it cannot start "
+                      << gameDirectory.string() << std::endl;
+            return false;
+        }
+
+        const std::string gameDir = gameDirectory.string();
+        for (size_t pos = customCommand.find("{gameDir}"); pos != std::string::npos;
+             pos = customCommand.find("{gameDir}", pos + gameDir.size())) {
+            customCommand.replace(pos, 9, gameDir);
+        }
+
         std::cout << "\nExecuting custom launch command..." << std::endl;
         std::cout << "Command: " << customCommand << std::endl;
 
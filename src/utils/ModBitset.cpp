@@ -0,0 +1,62 @@
+#include "ModBitset.h"
+#include <algorithm>
+
+ModBitset::ModBitset(size_t size, bool value)
+    : words((size + WORD_BITS - 1) / WORD_BITS, value ? ~uint64_t{0} : 0), bitCount(size) {
+    // Bits past the end stay clear so count() and none() need no masking
+    if (value && size % WORD_BITS != 0) {
+        words.back() &= (uint64_t{1} << (size % WORD_BITS)) - 1;
+    }
+}
+
+size_t ModBitset::count() const {
+    size_t total = 0;
+    for (const uint64_t word : words) {
+        total += static_cast<size_t>(std::popcount(word));
+    }
+    return total;
+}
+
+bool ModBitset::none() const {
+    return std::ranges::all_of(words, [](uint64_t word) { return word == 0; });
+}
+
+ModBitset ModBitset::lowest(size_t n) const {
+    ModBitset result(bitCount);
+
+    for (size_t w = 0; w < words.size() && n > 0; ++w) {
+        const auto bits = static_cast<size_t>(std::popcount(words[w]));
+        if (bits <= n) {
+            result.words[w] = words[w];
+            n -= bits;
+            continue;
+        }
+
+        for (uint64_t word = words[w]; n > 0; word &= word - 1, --n) {
+            result.words[w] |= word & ~(word - 1);
+        }
+    }
+
+    return result;
+}
+
+ModBitset& ModBitset::operator|=(const ModBitset& other) {
+    for (size_t w = 0; w < words.size(); ++w) {
+        words[w] |= other.words[w];
+    }
+    return *this;
+}
+
+ModBitset& ModBitset::operator&=(const ModBitset& other) {
+    for (size_t w = 0; w < words.size(); ++w) {
+        words[w] &= other.words[w];
+    }
+    return *this;
+}
+
+ModBitset& ModBitset::operator-=(const ModBitset& other) {
+    for (size_t w = 0; w < words.size(); ++w) {
+        words[w] &= ~other.words[w];
+    }
+    return *this;
+}
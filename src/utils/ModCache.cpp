@@ -0,0 +1,202 @@
+#include "ModCache.h"
+#include "Logger.h"
+#include <fstream>
+#include <cstdlib>
+
+json ModCacheEntry::toJson() const {
+    json j = {
+        {"fileSize", fileSize},
+        {"modifiedTime", modifiedTime},
+        {"parsed", parsed}
+    };
+
+    if (modJsonCrc) {
+        j["modJsonCrc"] = *modJsonCrc;
+    }
+    if (parsed) {
+        j["mod"] = mod.toJson();
+
+        j["nestedMods"] = json::array();
+        for (const auto& nested : nestedMods) {
+            j["nestedMods"].push_back(nested.toJson());
+        }
+    }
+
+    return j;
+}
+
+ModCacheEntry ModCacheEntry::fromJson(const json& j) {
+    ModCacheEntry entry;
+    entry.fileSize = j.value("fileSize", uintmax_t{0});
+    entry.modifiedTime = j.value("modifiedTime", int64_t{0});
+    entry.parsed = j.value("parsed", false);
+
+    if (j.contains("modJsonCrc")) {
+        entry.modJsonCrc = j["modJsonCrc"].get<uint32_t>();
+    }
+    if (entry.parsed && j.contains("mod")) {
+        entry.mod = ModInfo::fromJson(j["mod"]);
+    }
+    if (entry.parsed && j.contains("nestedMods")) {
+        for (const auto& nested : j["nestedMods"]) {
+            entry.nestedMods.push_back(ModInfo::fromJson(nested));
+        }
+    }
+
+    return entry;
+}
+
+ModCache::ModCache() {
+    cacheFilePath = getDefaultCachePath();
+}
+
+ModCache& ModCache::getInstance() {
+    static ModCache instance;
+    return instance;
+}
+
+bool ModCache::load() {
+    if (loaded) return true;
+    loaded = true;
+
+    if (!fs::exists(cacheFilePath)) {
+        LOG_DEBUG("No mod cache found: " + cacheFilePath.string());
+        return false;
+    }
+
+    try {
+        std::ifstream file(cacheFilePath);
+        if (!file.is_open()) {
+            LOG_ERROR("Failed to open mod cache: " + cacheFilePath.string());
+            return false;
+        }
+
+        json cacheJson;
+        file >> cacheJson;
+
+        if (cacheJson.value("formatVersion", 0) != FORMAT_VERSION) {
+            LOG_INFO("Discarding mod cache written by a different version");
+            dirty = true;
+            return false;
+        }
+
+        for (const auto& [jarPath, entryJson] : cacheJson["entries"].items()) {
+            entries[jarPath] = ModCacheEntry::fromJson(entryJson);
+        }
+
+        LOG_DEBUG("Mod cache loaded from: " + cacheFilePath.string());
+        return true;
+
+    } catch (const json::exception& e) {
+        LOG_ERROR("Failed to parse mod cache: " + std::string(e.what()));
+        entries.clear();
+        dirty = true;
+        return false;
+    }
+}
+
+bool ModCache::save() {
+    if (!dirty) return true;
+
+    try {
+        fs::path cacheDir = cacheFilePath.parent_path();
+        if (!cacheDir.empty() && !fs::exists(cacheDir)) {
+            fs::create_directories(cacheDir);
+        }
+
+        json entriesJson = json::object();
+        for (const auto& [jarPath, entry] : entries) {
+            entriesJson[jarPath] = entry.toJson();
+        }
+
+        // Write to a temporary file first so a crash never leaves a truncated cache behind
+        fs::path tempPath = cacheFilePath;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream file(tempPath);
+            if (!file.is_open()) {
+                LOG_ERROR("Failed to create mod cache: " + tempPath.string());
+                return false;
+            }
+            file << json{{"formatVersion", FORMAT_VERSION}, {"entries", entriesJson}}.dump();
+        }
+
+        fs::rename(tempPath, cacheFilePath);
+        dirty = false;
+
+        LOG_DEBUG("Mod cache saved to: " + cacheFilePath.string());
+        return true;
+
+    } catch (const std::exception& e) {
+        LOG_ERROR("Failed to save mod cache: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool ModCache::clear() {
+    entries.clear();
+    dirty = false;
+
+    try {
+        if (fs::exists(cacheFilePath)) {
+            fs::remove(cacheFilePath);
+            LOG_INFO("Mod cache cleared");
+        }
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR("Failed to clear mod cache: " + std::string(e.what()));
+        return false;
+    }
+}
+
+const ModCacheEntry* ModCache::find(const std::string& jarPath) const {
+    const auto it = entries.find(jarPath);
+    return it != entries.end() ? &it->second : nullptr;
+}
+
+void ModCache::store(const std::string& jarPath, const ModCacheEntry& entry) {
+    entries[jarPath] = entry;
+    dirty = true;
+}
+
+void ModCache::prune(const std::string& modsDir, const std::unordered_set<std::string>& presentJars) {
+    fs::path dir = fs::path(modsDir).lexically_normal();
+    if (!dir.has_filename()) dir = dir.parent_path();
+
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (fs::path(it->first).parent_path() == dir && !presentJars.contains(it->first)) {
+            it = entries.erase(it);
+            dirty = true;
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::string ModCache::getCachePath() const {
+    return cacheFilePath.string();
+}
+
+void ModCache::setCachePath(const fs::path& path) {
+    cacheFilePath = path;
+    entries.clear();
+    loaded = false;
+    dirty = false;
+}
+
+fs::path ModCache::getDefaultCachePath() const {
+#ifdef _WIN32
+    const char* appdata = std::getenv("APPDATA");
+    if (appdata) {
+        return fs::path(appdata) / "fabric-binary-search" / "mod-cache.json";
+    }
+    return fs::path("mod-cache.json");
+#else
+    const char* home = std::getenv("HOME");
+    if (home) {
+        return fs::path(home) / ".config" / "fabric-binary-search" / "mod-cache.json";
+    }
+    return fs::path("mod-cache.json");
+#endif
+}
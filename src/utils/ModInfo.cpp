@@ -1,168 +1,585 @@
 #include "ModInfo.h"
 #include <iostream>
-#include <regex>
-
-static std::string sanitizeJson(const std::string& jsonContent) {
-    std::string sanitized = jsonContent;
-    std::regex controlChars(R"(("(?:[^"\\]|\\.)*"))");
-
-    std::string result;
-    auto begin = std::sregex_iterator(sanitized.begin(), sanitized.end(), controlChars);
-    auto end = std::sregex_iterator();
-
-    size_t lastPos = 0;
-    for (auto it = begin; it != end; ++it) {
-        result.append(sanitized, lastPos, it->position() - lastPos);
-
-        std::string matched = it->str();
-        std::string cleaned;
-
-        for (size_t i = 0; i < matched.length(); ++i) {
-            if (char c = matched[i]; c < 0x20 && c != '\t' && i > 0 && matched[i-1] != '\\') {
-                switch (c) {
-                    case '\n': cleaned += "\\n"; break;
-                    case '\r': cleaned += "\\r"; break;
-                    case '\t': cleaned += "\\t"; break;
-                    default: break;
-                }
-            } else {
-                cleaned += c;
+#include <optional>
+#include <string_view>
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+
+constexpr int MAX_JSON_DEPTH = 256;
+
+// Forgiving single-pass reader over a JSON document. Hand-written fabric.mod.json files often
+// contain raw newlines or tabs inside strings, comments or trailing commas; all of those are
+// accepted. Values nobody asks for are stepped over without being materialized.
+class JsonCursor {
+public:
+    explicit JsonCursor(std::string_view text) : text(text) {
+        if (text.starts_with("\xEF\xBB\xBF")) pos = 3;
+    }
+
+    [[nodiscard]] bool ok() const { return error.empty(); }
+    [[nodiscard]] const std::string& getError() const { return error; }
+    [[nodiscard]] size_t position() const { return pos; }
+
+    // Next significant character without consuming it ('\0' at the end)
+    char peek() {
+        skipWhitespace();
+        return pos < text.size() ? text[pos] : '\0';
+    }
+
+    bool readString(std::string& out) {
+        out.clear();
+        if (peek() != '"') return fail("expected a string");
+        ++pos;
+
+        while (pos < text.size()) {
+            const size_t runStart = pos;
+            while (pos < text.size() && text[pos] != '"' && text[pos] != '\\' &&
+                   static_cast<unsigned char>(text[pos]) >= 0x20) {
+                ++pos;
+            }
+            out.append(text.substr(runStart, pos - runStart));
+            if (pos >= text.size()) break;
+
+            const char c = text[pos++];
+            if (c == '"') return true;
+
+            if (c != '\\') {
+                // Raw control character: keep line breaks and tabs, drop the rest
+                if (c == '\n' || c == '\r' || c == '\t') out += c;
+                continue;
+            }
+
+            if (pos >= text.size()) break;
+            switch (const char escaped = text[pos++]) {
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': appendUnicodeEscape(out); break;
+                default: out += escaped; break;
             }
         }
 
-        result.append(cleaned);
-        lastPos = it->position() + it->length();
+        return fail("unterminated string");
     }
 
-    result.append(sanitized, lastPos, sanitized.length() - lastPos);
-    return result.empty() ? sanitized : result;
-}
+    // Calls onMember(key) for each member; onMember consumes the value and returns ok()
+    template <typename Fn>
+    bool readObject(Fn&& onMember) {
+        if (peek() != '{') return fail("expected an object");
+        ++pos;
 
-bool ModInfo::parseFromJson(const std::string& jsonContent) {
-    try {
-        std::string sanitized = sanitizeJson(jsonContent);
-        json j = json::parse(sanitized);
+        std::string key;
+        while (true) {
+            const char c = peek();
+            if (c == '}') {
+                ++pos;
+                return true;
+            }
+            if (c != '"') return fail("expected a member name");
+            if (!readString(key)) return false;
+            if (peek() != ':') return fail("expected ':'");
+            ++pos;
 
-        // Store raw JSON for full metadata display
-        rawJson = j.dump(2);
+            if (!onMember(key)) return false;
 
-        if (!j.contains("id") || !j.contains("version")) {
-            std::cerr << "Missing required fields (id or version) in fabric.mod.json" << std::endl;
-            return false;
+            const char next = peek();
+            if (next == ',') {
+                ++pos;
+            } else if (next != '}') {
+                return fail("expected ',' or '}'");
+            }
         }
+    }
 
-        id = j["id"].get<std::string>();
+    // Calls onElement() for each element; onElement consumes it and returns ok()
+    template <typename Fn>
+    bool readArray(Fn&& onElement) {
+        if (peek() != '[') return fail("expected an array");
+        ++pos;
 
-        if (j["version"].is_string()) {
-            version = j["version"].get<std::string>();
-        } else if (j["version"].is_object()) {
-            if (j["version"].contains("en_us")) {
-                version = j["version"]["en_us"].get<std::string>();
-            } else {
-                version = j["version"].begin().value().get<std::string>();
+        while (true) {
+            const char c = peek();
+            if (c == ']') {
+                ++pos;
+                return true;
             }
-        } else {
-            version = j["version"].dump();
-        }
 
-        if (j.contains("name")) {
-            if (j["name"].is_string()) {
-                name = j["name"].get<std::string>();
-            } else if (j["name"].is_object()) {
-                if (j["name"].contains("en_us")) {
-                    name = j["name"]["en_us"].get<std::string>();
-                } else {
-                    name = j["name"].begin().value().get<std::string>();
-                }
-            } else {
-                name = id;
+            if (!onElement()) return false;
+
+            const char next = peek();
+            if (next == ',') {
+                ++pos;
+            } else if (next != ']') {
+                return fail("expected ',' or ']'");
             }
-        } else {
-            name = id;
         }
+    }
 
-        if (j.contains("description")) {
-            if (j["description"].is_string()) {
-                description = j["description"].get<std::string>();
-            } else if (j["description"].is_object()) {
-                if (j["description"].contains("en_us")) {
-                    description = j["description"]["en_us"].get<std::string>();
-                } else {
-                    description = j["description"].begin().value().get<std::string>();
-                }
+    bool skipValue(int depth = 0) {
+        if (depth > MAX_JSON_DEPTH) return fail("nested too deeply");
+
+        switch (peek()) {
+            case '"': {
+                std::string ignored;
+                return readString(ignored);
             }
+            case '{':
+                return readObject([&](const std::string&) { return skipValue(depth + 1); });
+            case '[':
+                return readArray([&] { return skipValue(depth + 1); });
+            case '\0':
+                return fail("unexpected end of document");
+            default:
+                return readScalar().has_value();
         }
+    }
 
-        if (j.contains("environment")) {
-            environment = j["environment"].get<std::string>();
-        } else {
-            environment = "*";
+    // Re-emits the next value as strict JSON; indent < 0 writes it compactly
+    bool format(std::string& out, int indent, int depth = 0) {
+        if (depth > MAX_JSON_DEPTH) return fail("nested too deeply");
+
+        const char c = peek();
+        if (c == '{' || c == '[') {
+            const bool isObject = c == '{';
+            bool empty = true;
+
+            out += c;
+            auto beginElement = [&] {
+                if (!empty) out += ',';
+                empty = false;
+                newline(out, indent, depth + 1);
+            };
+
+            const bool parsed = isObject
+                ? readObject([&](const std::string& key) {
+                      beginElement();
+                      appendQuoted(out, key);
+                      out += indent < 0 ? ":" : ": ";
+                      return format(out, indent, depth + 1);
+                  })
+                : readArray([&] {
+                      beginElement();
+                      return format(out, indent, depth + 1);
+                  });
+            if (!parsed) return false;
+
+            if (!empty) newline(out, indent, depth);
+            out += isObject ? '}' : ']';
+            return true;
         }
 
-        if (j.contains("authors")) {
-            if (j["authors"].is_array()) {
-                for (const auto& author : j["authors"]) {
-                    if (author.is_string()) {
-                        authors.push_back(author.get<std::string>());
-                    } else if (author.is_object() && author.contains("name")) {
-                        authors.push_back(author["name"].get<std::string>());
+        if (c == '"') {
+            std::string value;
+            if (!readString(value)) return false;
+            appendQuoted(out, value);
+            return true;
+        }
+
+        const auto scalar = readScalar();
+        if (!scalar) return false;
+        out += *scalar;
+        return true;
+    }
+
+    // number, true, false or null, as written
+    std::optional<std::string_view> readScalar() {
+        skipWhitespace();
+        const size_t start = pos;
+        while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) ||
+                                     text[pos] == '-' || text[pos] == '+' || text[pos] == '.')) {
+            ++pos;
+        }
+        if (pos == start) {
+            fail("unexpected character");
+            return std::nullopt;
+        }
+        return text.substr(start, pos - start);
+    }
+
+    bool fail(const std::string& message) {
+        if (error.empty()) error = message;
+        return false;
+    }
+
+    static void appendQuoted(std::string& out, std::string_view value) {
+        out += '"';
+        for (const char c : value) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\b': out += "\\b"; break;
+                case '\f': out += "\\f"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        static constexpr char HEX[] = "0123456789abcdef";
+                        out += "\\u00";
+                        out += HEX[c >> 4];
+                        out += HEX[c & 0xF];
+                    } else {
+                        out += c;
                     }
-                }
             }
         }
+        out += '"';
+    }
 
-        parseDependencies(j, "depends", depends);
-        parseDependencies(j, "suggests", suggests);
+private:
+    std::string_view text;
+    size_t pos = 0;
+    std::string error;
 
-        // Parse contact/links metadata
-        if (j.contains("contact")) {
-            const auto& contactObj = j["contact"];
-            if (contactObj.is_object()) {
-                if (contactObj.contains("homepage")) {
-                    homepage = contactObj["homepage"].get<std::string>();
-                }
-                if (contactObj.contains("sources")) {
-                    sources = contactObj["sources"].get<std::string>();
-                }
-                if (contactObj.contains("issues")) {
-                    issues = contactObj["issues"].get<std::string>();
-                }
-                // Store all contact fields
-                for (auto it = contactObj.begin(); it != contactObj.end(); ++it) {
-                    if (it.value().is_string()) {
-                        contact[it.key()] = it.value().get<std::string>();
-                    }
+    void skipWhitespace() {
+        while (pos < text.size()) {
+            const char c = text[pos];
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                ++pos;
+            } else if (text.substr(pos).starts_with("//")) {
+                const size_t end = text.find('\n', pos);
+                pos = end == std::string_view::npos ? text.size() : end + 1;
+            } else if (text.substr(pos).starts_with("/*")) {
+                const size_t end = text.find("*/", pos + 2);
+                pos = end == std::string_view::npos ? text.size() : end + 2;
+            } else {
+                break;
+            }
+        }
+    }
+
+    std::optional<uint32_t> readHex4() {
+        if (text.size() - pos < 4) return std::nullopt;
+
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char c = text[pos + i];
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= c - '0';
+            else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+            else return std::nullopt;
+        }
+        pos += 4;
+        return value;
+    }
+
+    void appendUnicodeEscape(std::string& out) {
+        const auto unit = readHex4();
+        uint32_t codePoint = unit.value_or(0xFFFD);
+
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+            codePoint = 0xFFFD;
+            if (text.substr(pos).starts_with("\\u")) {
+                pos += 2;
+                if (const auto low = readHex4(); low && *low >= 0xDC00 && *low <= 0xDFFF) {
+                    codePoint = 0x10000 + ((*unit - 0xD800) << 10) + (*low - 0xDC00);
                 }
             }
+        } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+            codePoint = 0xFFFD;
+        }
+
+        if (codePoint < 0x80) {
+            out += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    static void newline(std::string& out, int indent, int depth) {
+        if (indent < 0) return;
+        out += '\n';
+        out.append(static_cast<size_t>(indent) * depth, ' ');
+    }
+};
+
+// A plain string, or a translatable object keyed by locale (en_us preferred, else the first key)
+std::optional<std::string> readLocalizedString(JsonCursor& cursor) {
+    const char c = cursor.peek();
+    if (c == '"') {
+        std::string value;
+        if (cursor.readString(value)) return value;
+        return std::nullopt;
+    }
+
+    if (c != '{') {
+        cursor.skipValue();
+        return std::nullopt;
+    }
+
+    std::optional<std::string> english;
+    std::optional<std::string> first;
+    std::string firstLocale;
+
+    cursor.readObject([&](const std::string& locale) {
+        if (cursor.peek() != '"') return cursor.skipValue();
+
+        std::string value;
+        if (!cursor.readString(value)) return false;
+        if (locale == "en_us") {
+            english = value;
+        } else if (!first || locale < firstLocale) {
+            first = std::move(value);
+            firstLocale = locale;
+        }
+        return true;
+    });
+
+    return english ? english : first;
+}
+
+bool readStringField(JsonCursor& cursor, std::string& target) {
+    if (cursor.peek() != '"') return cursor.skipValue();
+    return cursor.readString(target);
+}
+
+// Strings of an array; object elements contribute their `memberOfObject` string (e.g. an author's "name")
+bool readStringArray(JsonCursor& cursor, std::vector<std::string>& target, const char* memberOfObject) {
+    if (cursor.peek() != '[') return cursor.skipValue();
+
+    target.clear();
+    return cursor.readArray([&] {
+        const char c = cursor.peek();
+        if (c == '"') {
+            std::string value;
+            if (!cursor.readString(value)) return false;
+            target.push_back(std::move(value));
+            return true;
         }
 
+        if (c != '{' || !memberOfObject) return cursor.skipValue();
+
+        return cursor.readObject([&](const std::string& key) {
+            if (key != memberOfObject || cursor.peek() != '"') return cursor.skipValue();
+
+            std::string value;
+            if (!cursor.readString(value)) return false;
+            target.push_back(std::move(value));
+            return true;
+        });
+    });
+}
+
+bool readDependencies(JsonCursor& cursor, std::unordered_map<std::string, std::string>& target) {
+    if (cursor.peek() != '{') return cursor.skipValue();
+
+    target.clear();
+    return cursor.readObject([&](const std::string& modId) {
+        std::string versionReq;
+
+        const char c = cursor.peek();
+        if (c == '"') {
+            if (!cursor.readString(versionReq)) return false;
+        } else if (c == '[') {
+            // Any of several ranges; kept as compact JSON like before
+            if (!cursor.format(versionReq, -1)) return false;
+        } else if (!cursor.skipValue()) {
+            return false;
+        }
+
+        target[modId] = std::move(versionReq);
+        return true;
+    });
+}
+
+bool readIcon(JsonCursor& cursor, std::string& icon) {
+    if (cursor.peek() != '{') return readStringField(cursor, icon);
+
+    // Sized icons are keyed by pixel width; keep the largest
+    int bestSize = -1;
+    return cursor.readObject([&](const std::string& key) {
+        if (cursor.peek() != '"') return cursor.skipValue();
+
+        std::string path;
+        if (!cursor.readString(path)) return false;
+
+        const int size = std::atoi(key.c_str());
+        if (size > bestSize) {
+            bestSize = size;
+            icon = std::move(path);
+        }
         return true;
+    });
+}
+
+} // namespace
+
+bool ModInfo::parseFromJson(const std::string& jsonContent) {
+    if (!parseFields(jsonContent)) return false;
+
+    source = CompressedText::compress(jsonContent);
+    return true;
+}
+
+bool ModInfo::parseFromJson(const std::string& jsonContent, CompressedText compressedSource) {
+    if (!parseFields(jsonContent)) return false;
+
+    source = std::move(compressedSource);
+    return true;
+}
+
+bool ModInfo::parseFields(const std::string& jsonContent) {
+    JsonCursor cursor(jsonContent);
+
+    bool hasId = false;
+    bool hasVersion = false;
+    std::optional<std::string> localizedName;
+    environment = "*";
+
+    // One pass over the document, picking out the fields the scan uses and skipping everything
+    // else; the display-only fields are left for loadMetadata()
+    const bool parsed = cursor.readObject([&](const std::string& key) {
+        if (key == "id") {
+            hasId = cursor.peek() == '"';
+            readStringField(cursor, id);
+        } else if (key == "version") {
+            const char c = cursor.peek();
+            if (c == '"' || c == '{') {
+                const auto localized = readLocalizedString(cursor);
+                hasVersion = localized.has_value();
+                version = localized.value_or("");
+            } else if (c == '[') {
+                hasVersion = cursor.format(version, -1);
+            } else if (const auto scalar = cursor.readScalar()) {
+                hasVersion = true;
+                version = std::string(*scalar);
+            }
+        } else if (key == "name") {
+            localizedName = readLocalizedString(cursor);
+        } else if (key == "environment") {
+            readStringField(cursor, environment);
+        } else if (key == "depends") {
+            readDependencies(cursor, depends);
+        } else if (key == "suggests") {
+            readDependencies(cursor, suggests);
+        } else if (key == "provides") {
+            readStringArray(cursor, provides, nullptr);
+        } else if (key == "mixins") {
+            readStringArray(cursor, mixins, "config");
+        } else if (key == "accessWidener") {
+            readStringField(cursor, accessWidener);
+        } else if (key == "icon") {
+            readIcon(cursor, icon);
+        } else if (key == "jars") {
+            readStringArray(cursor, jars, "file");
+        } else {
+            cursor.skipValue();
+        }
+
+        return cursor.ok();
+    });
+
+    if (!parsed) {
+        std::cerr << "JSON parsing error at offset " << cursor.position() << ": "
+                  << cursor.getError() << std::endl;
+        return false;
+    }
 
-    } catch (const json::exception& e) {
-        std::cerr << "JSON parsing error: " << e.what() << std::endl;
+    if (!hasId || !hasVersion) {
+        std::cerr << "Missing required fields (id or version) in fabric.mod.json" << std::endl;
         return false;
     }
+
+    name = localizedName.value_or(id);
+    return true;
 }
 
-void ModInfo::parseDependencies(const json& j, const std::string& key,
-                                std::unordered_map<std::string, std::string>& target) {
-    if (!j.contains(key)) return;
+ModMetadata ModInfo::loadMetadata() const {
+    ModMetadata metadata;
 
-    const auto& deps = j[key];
-    if (!deps.is_object()) return;
+    const std::string text = source.decompress();
+    if (text.empty()) return metadata;
 
-    for (auto it = deps.begin(); it != deps.end(); ++it) {
-        const std::string& modId = it.key();
-        std::string versionReq;
+    JsonCursor cursor(text);
+    cursor.readObject([&](const std::string& key) {
+        if (key == "description") {
+            metadata.description = readLocalizedString(cursor).value_or("");
+        } else if (key == "authors") {
+            readStringArray(cursor, metadata.authors, "name");
+        } else if (key == "contact") {
+            if (cursor.peek() != '{') return cursor.skipValue();
 
-        if (it.value().is_string()) {
-            versionReq = it.value().get<std::string>();
-        } else if (it.value().is_array()) {
-            versionReq = it.value().dump();
+            metadata.contact.clear();
+            return cursor.readObject([&](const std::string& field) {
+                if (cursor.peek() != '"') return cursor.skipValue();
+
+                std::string value;
+                if (!cursor.readString(value)) return false;
+                if (field == "homepage") metadata.homepage = value;
+                else if (field == "sources") metadata.sources = value;
+                else if (field == "issues") metadata.issues = value;
+                metadata.contact[field] = std::move(value);
+                return true;
+            });
+        } else {
+            cursor.skipValue();
         }
 
-        target[modId] = versionReq;
+        return cursor.ok();
+    });
+
+    JsonCursor formatter(text);
+    if (!formatter.format(metadata.rawJson, 2)) {
+        metadata.rawJson = text;
+    }
+
+    return metadata;
+}
+
+json ModInfo::toJson() const {
+    return {
+        {"id", id},
+        {"name", name},
+        {"version", version},
+        {"depends", depends},
+        {"suggests", suggests},
+        {"provides", provides},
+        {"environment", environment},
+        {"jars", jars},
+        {"mixins", mixins},
+        {"accessWidener", accessWidener},
+        {"icon", icon},
+        {"providedBy", providedBy},
+        {"source", source.toBase64()},
+        {"sourceSize", source.size()}
+    };
+}
+
+ModInfo ModInfo::fromJson(const json& j) {
+    using StringMap = std::unordered_map<std::string, std::string>;
+
+    ModInfo mod;
+    mod.id = j.value("id", "");
+    mod.name = j.value("name", "");
+    mod.version = j.value("version", "");
+    mod.depends = j.value("depends", StringMap{});
+    mod.suggests = j.value("suggests", StringMap{});
+    mod.provides = j.value("provides", std::vector<std::string>{});
+    mod.environment = j.value("environment", "*");
+    mod.jars = j.value("jars", std::vector<std::string>{});
+    mod.mixins = j.value("mixins", std::vector<std::string>{});
+    mod.accessWidener = j.value("accessWidener", "");
+    mod.icon = j.value("icon", "");
+    mod.providedBy = j.value("providedBy", "");
+    if (auto cachedSource = CompressedText::fromBase64(j.value("source", ""), j.value("sourceSize", 0u))) {
+        mod.source = std::move(*cachedSource);
     }
+    return mod;
 }
 
 bool ModInfo::dependsOn(const std::string& modId) const {
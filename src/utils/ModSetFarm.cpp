@@ -0,0 +1,328 @@
+#include "ModSetFarm.h"
+#include "Logger.h"
+#include <algorithm>
+#include <charconv>
+
+namespace {
+
+std::vector<fs::directory_entry> listDirectory(const fs::path& dir, std::error_code& ec) {
+    std::vector<fs::directory_entry> files;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        files.push_back(*it);
+    }
+    return files;
+}
+
+std::string withoutDisabled(const std::string& name) {
+    return name.ends_with(".disabled") ? name.substr(0, name.size() - 9) : name;
+}
+
+} // namespace
+
+ModSetFarm::ModSetFarm(const fs::path& modsDirectory) {
+    std::error_code ec;
+    modsDir = fs::absolute(modsDirectory, ec).lexically_normal();
+    if (!modsDir.has_filename()) modsDir = modsDir.parent_path();
+
+    root = modsDir.parent_path() / ".fabric-binary-search";
+    storeDir = root / "store";
+    setsDir = root / "sets";
+}
+
+bool ModSetFarm::isActive() const {
+    const fs::path set = currentSet();
+    return !set.empty() && set.parent_path() == setsDir;
+}
+
+bool ModSetFarm::convert() {
+    if (isActive()) return true;
+
+    std::error_code ec;
+    if (fs::is_symlink(modsDir, ec) || !fs::is_directory(modsDir, ec)) {
+        LOG_ERROR("Only a plain mods directory can be converted: " + modsDir.string());
+        return false;
+    }
+    if (fs::exists(storeDir, ec) || fs::exists(setsDir, ec)) {
+        LOG_ERROR(root.string() + " is left over from before; move it out of the way first");
+        return false;
+    }
+
+    fs::create_directories(setsDir, ec);
+    if (ec) {
+        LOG_ERROR("Failed to create " + setsDir.string() + ": " + ec.message());
+        return false;
+    }
+
+    // Checked before mods/ is moved, so nothing needs undoing where links are not allowed
+    if (!canSymlink()) {
+        fs::remove(setsDir, ec);
+        fs::remove(root, ec);
+        return false;
+    }
+
+    // mods/ is missing until the first set is linked; recover() picks up from here
+    fs::rename(modsDir, storeDir, ec);
+    if (ec) {
+        LOG_ERROR("Failed to move the mods directory into the store: " + ec.message());
+        fs::remove(setsDir, ec);
+        return false;
+    }
+
+    std::vector<Entry> entries;
+    if (!readStore(entries) || !activate(entries)) {
+        fs::rename(storeDir, modsDir, ec);
+        if (!ec) fs::remove_all(setsDir, ec);
+        return false;
+    }
+
+    LOG_INFO("Mods directory now switches through a symlink into " + root.string());
+    return true;
+}
+
+bool ModSetFarm::revert() {
+    if (!isActive()) return true;
+    return finishRevert();
+}
+
+bool ModSetFarm::switchTo(const std::unordered_map<std::string, bool>& enabledByName) {
+    std::vector<Entry> entries;
+    if (!readLiveSet(entries)) return false;
+
+    for (auto& entry : entries) {
+        if (const auto it = enabledByName.find(entry.name); it != enabledByName.end()) {
+            entry.enabled = it->second;
+        }
+    }
+
+    return activate(entries);
+}
+
+void ModSetFarm::recover() {
+    std::error_code ec;
+
+    if (fs::is_directory(root / "reverting", ec)) {
+        finishRevert();
+        return;
+    }
+
+    if (fs::exists(fs::symlink_status(modsDir, ec)) || !fs::is_directory(storeDir, ec)) return;
+
+    std::vector<Entry> entries;
+    if (readStore(entries) && activate(entries)) {
+        LOG_INFO("Finished converting the mods directory to a symlinked mod set");
+    }
+}
+
+bool ModSetFarm::readLiveSet(std::vector<Entry>& entries) const {
+    std::error_code ec;
+    const auto files = listDirectory(modsDir, ec);
+    if (ec) {
+        LOG_ERROR("Failed to read the current mod set: " + ec.message());
+        return false;
+    }
+
+    for (const auto& file : files) {
+        const std::string name = file.path().filename().string();
+        const std::string base = withoutDisabled(name);
+        Entry entry{"", base, name == base};
+
+        for (const std::string& candidate : {base, base + ".disabled"}) {
+            std::error_code linkEc;
+            if (fs::equivalent(file.path(), storeDir / candidate, linkEc)) {
+                entry.storeName = candidate;
+                break;
+            }
+        }
+
+        if (entry.storeName.empty()) {
+            if (!fs::exists(file.path(), ec)) {
+                LOG_WARNING("Dropping " + name + " from the mod set: it links to a missing file");
+                continue;
+            }
+
+            // Dropped into mods/ directly (e.g. an update), so it lives in the store from now on
+            fs::rename(file.path(), storeDir / name, ec);
+            if (ec) {
+                LOG_ERROR("Failed to move " + name + " into the mod store: " + ec.message());
+                return false;
+            }
+            entry.storeName = name;
+        }
+
+        entries.push_back(std::move(entry));
+    }
+
+    return true;
+}
+
+bool ModSetFarm::readStore(std::vector<Entry>& entries) const {
+    std::error_code ec;
+    const auto files = listDirectory(storeDir, ec);
+    if (ec) {
+        LOG_ERROR("Failed to read the mod store: " + ec.message());
+        return false;
+    }
+
+    for (const auto& file : files) {
+        const std::string name = file.path().filename().string();
+        const std::string base = withoutDisabled(name);
+        entries.push_back({name, base, name == base});
+    }
+
+    return true;
+}
+
+bool ModSetFarm::activate(const std::vector<Entry>& entries) {
+    const fs::path setDir = nextSetPath();
+
+    std::error_code ec;
+    fs::create_directories(setDir, ec);
+    if (ec) {
+        LOG_ERROR("Failed to create mod set " + setDir.string() + ": " + ec.message());
+        return false;
+    }
+
+    // Relative, so the instance folder can still be moved or copied as a whole
+    const fs::path storeFromSet = fs::path("..") / ".." / storeDir.filename();
+
+    for (const auto& entry : entries) {
+        const fs::path target = storeDir / entry.storeName;
+        const fs::path link = setDir / (entry.enabled ? entry.name : entry.name + ".disabled");
+
+        if (fs::is_directory(target, ec)) {
+            fs::create_directory_symlink(storeFromSet / entry.storeName, link, ec);
+        } else {
+            fs::create_symlink(storeFromSet / entry.storeName, link, ec);
+        }
+
+        if (ec) {
+            LOG_ERROR("Failed to link " + entry.storeName + " into a new mod set: " + ec.message());
+            fs::remove_all(setDir, ec);
+            return false;
+        }
+    }
+
+    if (!repoint(setDir)) {
+        fs::remove_all(setDir, ec);
+        return false;
+    }
+
+    // The previous set, and any left behind by a switch that was cut short
+    for (const auto& set : listDirectory(setsDir, ec)) {
+        if (set.path() != setDir) fs::remove_all(set.path(), ec);
+    }
+
+    return true;
+}
+
+bool ModSetFarm::repoint(const fs::path& setDir) const {
+    const fs::path staging = root / "switching";
+
+    std::error_code ec;
+    fs::remove(staging, ec);
+    fs::create_directory_symlink(setDir.lexically_relative(modsDir.parent_path()), staging, ec);
+    if (ec) {
+        LOG_ERROR("Failed to create a symlink for the mods directory: " + ec.message());
+        return false;
+    }
+
+    // Replaces the old symlink in one step (atomic on POSIX), so mods/ always has a whole set
+    fs::rename(staging, modsDir, ec);
+    if (ec) {
+        LOG_ERROR("Failed to switch the mods directory to " + setDir.string() + ": " + ec.message());
+        fs::remove(staging, ec);
+        return false;
+    }
+
+    return true;
+}
+
+bool ModSetFarm::canSymlink() const {
+    const fs::path probe = root / "symlink-check";
+
+    std::error_code ec;
+    fs::remove(probe, ec);
+    fs::create_directory_symlink(setsDir.lexically_relative(root), probe, ec);
+    if (ec) {
+        LOG_ERROR("Mod sets need symlinks, which cannot be created here: " + ec.message());
+        return false;
+    }
+
+    fs::remove(probe, ec);
+    return true;
+}
+
+bool ModSetFarm::finishRevert() {
+    const fs::path staging = root / "reverting";
+
+    std::error_code ec;
+    fs::create_directories(staging, ec);
+    if (ec) {
+        LOG_ERROR("Failed to create " + staging.string() + ": " + ec.message());
+        return false;
+    }
+
+    // Idempotent, so recover() can run it again: links whose store file already moved are skipped
+    if (const fs::path setDir = currentSet(); !setDir.empty()) {
+        for (const auto& file : listDirectory(setDir, ec)) {
+            fs::path source = file.path();
+            if (file.is_symlink()) {
+                const fs::path target = (setDir / fs::read_symlink(file.path(), ec)).lexically_normal();
+                if (target.parent_path() == storeDir) {
+                    if (!fs::exists(fs::symlink_status(target, ec))) continue;
+                    source = target;
+                }
+            }
+
+            fs::rename(source, staging / file.path().filename(), ec);
+            if (ec) {
+                LOG_ERROR("Failed to move " + source.string() + " back into the mods directory: " + ec.message());
+                return false;
+            }
+        }
+    }
+
+    // A symlink can't be swapped for a directory in one rename; recover() finishes this if cut short
+    if (fs::is_symlink(modsDir, ec)) fs::remove(modsDir, ec);
+    fs::rename(staging, modsDir, ec);
+    if (ec) {
+        LOG_ERROR("Failed to restore the mods directory: " + ec.message());
+        return false;
+    }
+
+    // Anything still in the store was deleted from mods/, but is kept rather than lost
+    fs::remove_all(setsDir, ec);
+    fs::remove(storeDir, ec);
+    if (ec) {
+        LOG_WARNING("Files deleted from mods/ while it was symlinked are still in " + storeDir.string());
+    } else {
+        fs::remove(root, ec);
+    }
+
+    LOG_INFO("Mods directory is a plain directory again");
+    return true;
+}
+
+fs::path ModSetFarm::currentSet() const {
+    std::error_code ec;
+    if (!fs::is_symlink(modsDir, ec)) return {};
+
+    const fs::path target = fs::read_symlink(modsDir, ec);
+    if (ec) return {};
+    return (modsDir.parent_path() / target).lexically_normal();
+}
+
+fs::path ModSetFarm::nextSetPath() const {
+    unsigned long next = 0;
+
+    std::error_code ec;
+    for (const auto& set : listDirectory(setsDir, ec)) {
+        const std::string name = set.path().filename().string();
+        unsigned long number = 0;
+        if (std::from_chars(name.data(), name.data() + name.size(), number).ec == std::errc()) {
+            next = std::max(next, number + 1);
+        }
+    }
+
+    return setsDir / std::to_string(next);
+}
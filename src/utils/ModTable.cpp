@@ -0,0 +1,130 @@
+#include "ModTable.h"
+#include <algorithm>
+#include <ranges>
+
+void ModTable::build(const std::vector<ModInfo>& mods, const std::vector<ModInfo>& providedMods) {
+    clear();
+
+    // The symbol index keys point into the arena, so it must be sized up front and never grow
+    size_t arenaSize = 0;
+    for (const auto& mod : mods) {
+        arenaSize += mod.id.size() + mod.version.size() + mod.jarPath.size();
+        for (const auto& depId : mod.depends | std::views::keys) arenaSize += depId.size();
+        for (const auto& alias : mod.provides) arenaSize += alias.size();
+    }
+    for (const auto& mod : providedMods) {
+        arenaSize += mod.id.size();
+        for (const auto& depId : mod.depends | std::views::keys) arenaSize += depId.size();
+        for (const auto& alias : mod.provides) arenaSize += alias.size();
+    }
+    arena.reserve(arenaSize);
+
+    modSymbols.reserve(mods.size());
+    versions.reserve(mods.size());
+    jarPaths.reserve(mods.size());
+
+    for (ModHandle handle = 0; handle < mods.size(); ++handle) {
+        const Symbol symbol = intern(mods[handle].id);
+        if (providers[symbol] == NO_PROVIDER) providers[symbol] = handle;
+
+        modSymbols.push_back(symbol);
+        versions.push_back(store(mods[handle].version));
+        jarPaths.push_back(store(mods[handle].jarPath));
+    }
+
+    // A JAR needs what it and everything bundled in it depends on
+    std::vector<std::vector<Symbol>> needs(mods.size());
+    for (ModHandle handle = 0; handle < mods.size(); ++handle) {
+        for (const auto& depId : mods[handle].depends | std::views::keys) {
+            needs[handle].push_back(intern(depId));
+        }
+    }
+
+    for (const auto& nested : providedMods) {
+        const auto container = findHandle(nested.providedBy);
+        if (!container) continue;
+
+        const Symbol symbol = intern(nested.id);
+        if (providers[symbol] == NO_PROVIDER) providers[symbol] = *container;
+
+        for (const auto& depId : nested.depends | std::views::keys) {
+            needs[*container].push_back(intern(depId));
+        }
+    }
+
+    // Aliases last, so a real mod or nested mod with the same ID takes precedence
+    const auto addAliases = [&](const ModInfo& mod, std::optional<ModHandle> jar) {
+        if (!jar) return;
+        for (const auto& alias : mod.provides) {
+            const Symbol symbol = intern(alias);
+            if (providers[symbol] == NO_PROVIDER) providers[symbol] = *jar;
+        }
+    };
+    for (ModHandle handle = 0; handle < mods.size(); ++handle) {
+        addAliases(mods[handle], handle);
+    }
+    for (const auto& nested : providedMods) {
+        addAliases(nested, findHandle(nested.providedBy));
+    }
+
+    dependencyStart.reserve(mods.size() + 1);
+    dependencyStart.push_back(0);
+    for (ModHandle handle = 0; handle < mods.size(); ++handle) {
+        auto& symbols = needs[handle];
+        std::ranges::sort(symbols);
+        const auto duplicates = std::ranges::unique(symbols);
+        symbols.erase(duplicates.begin(), duplicates.end());
+
+        for (const Symbol symbol : symbols) {
+            if (providers[symbol] != handle) dependencySymbols.push_back(symbol);
+        }
+        dependencyStart.push_back(static_cast<uint32_t>(dependencySymbols.size()));
+    }
+}
+
+void ModTable::clear() {
+    arena.clear();
+    symbolNames.clear();
+    symbolIndex.clear();
+    providers.clear();
+    modSymbols.clear();
+    versions.clear();
+    jarPaths.clear();
+    dependencyStart.clear();
+    dependencySymbols.clear();
+}
+
+std::optional<ModTable::Symbol> ModTable::findSymbol(std::string_view modId) const {
+    const auto it = symbolIndex.find(modId);
+    if (it == symbolIndex.end()) return std::nullopt;
+    return it->second;
+}
+
+std::optional<ModHandle> ModTable::findHandle(std::string_view modId) const {
+    const auto symbol = findSymbol(modId);
+    if (!symbol || providers[*symbol] == NO_PROVIDER || modSymbols[providers[*symbol]] != *symbol) {
+        return std::nullopt;
+    }
+    return providers[*symbol];
+}
+
+std::optional<ModHandle> ModTable::providerOf(Symbol symbol) const {
+    if (providers[symbol] == NO_PROVIDER) return std::nullopt;
+    return providers[symbol];
+}
+
+ModTable::StringRef ModTable::store(std::string_view text) {
+    const StringRef ref{static_cast<uint32_t>(arena.size()), static_cast<uint32_t>(text.size())};
+    arena.append(text);
+    return ref;
+}
+
+ModTable::Symbol ModTable::intern(std::string_view modId) {
+    if (const auto it = symbolIndex.find(modId); it != symbolIndex.end()) return it->second;
+
+    const auto symbol = static_cast<Symbol>(symbolNames.size());
+    symbolNames.push_back(store(modId));
+    symbolIndex.emplace(name(symbol), symbol);
+    providers.push_back(NO_PROVIDER);
+    return symbol;
+}
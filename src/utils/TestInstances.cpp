@@ -0,0 +1,73 @@
+#include "TestInstances.h"
+#include "Logger.h"
+
+TestInstances::TestInstances(const fs::path& modsDirectory) {
+    std::error_code ec;
+    fs::path modsDir = fs::absolute(modsDirectory, ec).lexically_normal();
+    if (!modsDir.has_filename()) modsDir = modsDir.parent_path();
+
+    instanceDir = modsDir.parent_path();
+    root = instanceDir / ".fabric-binary-search" / "instances";
+}
+
+bool TestInstances::prepare(size_t slot, const std::vector<fs::path>& jars) {
+    const fs::path gameDir = gameDirectory(slot);
+    const fs::path modsDir = gameDir / "mods";
+
+    // Links from an earlier round would leave mods enabled that this test should not have
+    std::error_code ec;
+    fs::remove_all(modsDir, ec);
+    fs::create_directories(modsDir, ec);
+    if (ec) {
+        LOG_ERROR("Failed to create " + modsDir.string() + ": " + ec.message());
+        return false;
+    }
+
+    for (const auto& jar : jars) {
+        // The real file, in case mods/ is itself a symlinked mod set
+        const fs::path target = fs::canonical(jar, ec);
+        if (ec) {
+            LOG_ERROR("Cannot link " + jar.string() + " into a test instance: " + ec.message());
+            return false;
+        }
+
+        const fs::path link = modsDir / jar.filename();
+        fs::create_symlink(target, link, ec);
+        if (ec) {
+            ec.clear();
+            fs::create_hard_link(target, link, ec);
+        }
+        if (ec) {
+            LOG_ERROR("Failed to link " + jar.filename().string() + " into " + modsDir.string() + ": " + ec.message());
+            return false;
+        }
+    }
+
+    // Mods read their settings from config/, and players expect their own options
+    const fs::path configDir = instanceDir / "config";
+    if (fs::is_directory(configDir, ec) && !fs::exists(fs::symlink_status(gameDir / "config", ec))) {
+        fs::create_directory_symlink(configDir, gameDir / "config", ec);
+        if (ec) LOG_WARNING("Test instance " + std::to_string(slot) + " starts without the mod configs: " + ec.message());
+    }
+    if (fs::exists(instanceDir / "options.txt", ec)) {
+        fs::copy_file(instanceDir / "options.txt", gameDir / "options.txt", fs::copy_options::skip_existing, ec);
+    }
+
+    return true;
+}
+
+fs::path TestInstances::gameDirectory(size_t slot) const {
+    return root / std::to_string(slot);
+}
+
+void TestInstances::clear() {
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    if (ec) {
+        LOG_WARNING("Failed to remove the test instances in " + root.string() + ": " + ec.message());
+        return;
+    }
+
+    // Only if nothing else (such as a symlinked mod set) lives there
+    fs::remove(root.parent_path(), ec);
+}
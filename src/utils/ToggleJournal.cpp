@@ -0,0 +1,180 @@
+#include "ToggleJournal.h"
+#include "Logger.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace {
+
+// Paths go on one line each, with the two sides of a rename separated by a tab
+std::string escape(const std::string& path) {
+    std::string escaped;
+    escaped.reserve(path.size());
+    for (const char c : path) {
+        if (c == '\\') escaped += "\\\\";
+        else if (c == '\t') escaped += "\\t";
+        else if (c == '\n') escaped += "\\n";
+        else escaped += c;
+    }
+    return escaped;
+}
+
+std::string unescape(const std::string& text) {
+    std::string path;
+    path.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '\\' || i + 1 == text.size()) {
+            path += text[i];
+            continue;
+        }
+
+        const char c = text[++i];
+        path += c == 't' ? '\t' : c == 'n' ? '\n' : c;
+    }
+    return path;
+}
+
+} // namespace
+
+ToggleJournal::ToggleJournal() {
+    journalFilePath = getDefaultJournalPath();
+}
+
+ToggleJournal& ToggleJournal::getInstance() {
+    static ToggleJournal instance;
+    return instance;
+}
+
+bool ToggleJournal::begin(const std::vector<Rename>& renames) {
+    std::error_code ec;
+    fs::create_directories(journalFilePath.parent_path(), ec);
+
+    // Everything before this batch is done, so a large journal can start over
+    if (fs::file_size(journalFilePath, ec) > COMPACT_THRESHOLD && !ec) {
+        fs::resize_file(journalFilePath, 0, ec);
+    }
+
+    // The journal is shared by every run, so relative paths would resolve against whatever
+    // directory recover() happens to start in
+    std::string batch = "begin " + std::to_string(renames.size()) + "\n";
+    for (const auto& [from, to] : renames) {
+        batch += "rename " + escape(fs::absolute(from, ec).string()) + "\t" +
+                 escape(fs::absolute(to, ec).string()) + "\n";
+    }
+
+    // The marker goes in its own write so it can only be on disk if the whole batch is
+    return append(batch) && append("ready\n");
+}
+
+void ToggleJournal::commit() {
+    append("done\n");
+}
+
+size_t ToggleJournal::recover() {
+    std::ifstream file(journalFilePath);
+    if (!file.is_open()) return 0;
+
+    std::vector<Rename> renames;
+    bool inBatch = false;
+    bool ready = false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.starts_with("begin ")) {
+            renames.clear();
+            inBatch = true;
+            ready = false;
+        } else if (line.starts_with("rename ") && inBatch && !ready) {
+            const size_t tab = line.find('\t');
+            if (tab == std::string::npos) continue;
+            renames.push_back({unescape(line.substr(7, tab - 7)), unescape(line.substr(tab + 1))});
+        } else if (line == "ready" && inBatch) {
+            ready = true;
+        } else if (line == "done") {
+            inBatch = false;
+        }
+    }
+    file.close();
+
+    if (!inBatch) return 0;
+
+    if (!ready) {
+        LOG_WARNING("Dropping a mod toggle batch that was interrupted before it started");
+        commit();
+        return 0;
+    }
+
+    size_t redone = 0;
+    for (const auto& [from, to] : renames) {
+        std::error_code ec;
+        const bool fromExists = fs::exists(from, ec);
+        const bool toExists = fs::exists(to, ec);
+
+        if (fromExists && !toExists) {
+            fs::rename(from, to, ec);
+            if (ec) {
+                LOG_ERROR("Could not finish renaming " + from + ": " + ec.message());
+                continue;
+            }
+            redone++;
+        } else if (!toExists) {
+            LOG_WARNING("Cannot finish renaming " + from + ": the file is gone");
+        }
+    }
+
+    LOG_INFO("Finished an interrupted mod toggle batch (" + std::to_string(redone) + " of " +
+             std::to_string(renames.size()) + " renames were left)");
+    commit();
+    return redone;
+}
+
+std::string ToggleJournal::getJournalPath() const {
+    return journalFilePath.string();
+}
+
+void ToggleJournal::setJournalPath(const fs::path& path) {
+    journalFilePath = path;
+}
+
+bool ToggleJournal::append(const std::string& text) const {
+    std::FILE* file = std::fopen(journalFilePath.string().c_str(), "ab");
+    if (!file) {
+        LOG_ERROR("Failed to open toggle journal: " + journalFilePath.string());
+        return false;
+    }
+
+    bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size() && std::fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = std::fclose(file) == 0 && ok;
+
+    if (!ok) {
+        LOG_ERROR("Failed to write toggle journal: " + journalFilePath.string());
+    }
+    return ok;
+}
+
+fs::path ToggleJournal::getDefaultJournalPath() const {
+#ifdef _WIN32
+    const char* appdata = std::getenv("APPDATA");
+    if (appdata) {
+        return fs::path(appdata) / "fabric-binary-search" / "toggle-journal.log";
+    }
+    return fs::path("toggle-journal.log");
+#else
+    const char* home = std::getenv("HOME");
+    if (home) {
+        return fs::path(home) / ".config" / "fabric-binary-search" / "toggle-journal.log";
+    }
+    return fs::path("toggle-journal.log");
+#endif
+}
@@ -0,0 +1,216 @@
+#include "UringReader.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+        #define FABRICBINARYSEARCH_HAS_IO_URING
+    #endif
+#endif
+
+#ifdef FABRICBINARYSEARCH_HAS_IO_URING
+
+namespace {
+
+// liburing is not a dependency; the two syscalls and the shared rings are all we need
+int ioUringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+unsigned loadAcquire(unsigned* value) {
+    return std::atomic_ref<unsigned>(*value).load(std::memory_order_acquire);
+}
+
+void storeRelease(unsigned* value, unsigned newValue) {
+    std::atomic_ref<unsigned>(*value).store(newValue, std::memory_order_release);
+}
+
+} // namespace
+
+bool UringReader::isSupported() {
+    static const bool supported = [] {
+        const UringReader probe(1);
+        return probe.isOpen();
+    }();
+    return supported;
+}
+
+UringReader::UringReader(unsigned queueDepth) {
+    io_uring_params params{};
+    ringFd = ioUringSetup(queueDepth, &params);
+    if (ringFd < 0) {
+        ringFd = -1;
+        return;
+    }
+
+    // Kernels without a single mapping for both rings (pre-5.4) are not worth a second code path
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP)) {
+        ::close(ringFd);
+        ringFd = -1;
+        return;
+    }
+
+    ringSize = std::max<size_t>(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                                params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    ringMemory = ::mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ringFd, IORING_OFF_SQ_RING);
+
+    sqeSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqeMemory = ::mmap(nullptr, sqeSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       ringFd, IORING_OFF_SQES);
+
+    if (ringMemory == MAP_FAILED || sqeMemory == MAP_FAILED) {
+        if (ringMemory != MAP_FAILED) ::munmap(ringMemory, ringSize);
+        if (sqeMemory != MAP_FAILED) ::munmap(sqeMemory, sqeSize);
+        ringMemory = nullptr;
+        sqeMemory = nullptr;
+        ::close(ringFd);
+        ringFd = -1;
+        return;
+    }
+
+    auto* ring = static_cast<char*>(ringMemory);
+    sqHead = reinterpret_cast<unsigned*>(ring + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned*>(ring + params.sq_off.tail);
+    sqMask = reinterpret_cast<unsigned*>(ring + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned*>(ring + params.sq_off.array);
+    sqEntries = params.sq_entries;
+
+    cqHead = reinterpret_cast<unsigned*>(ring + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned*>(ring + params.cq_off.tail);
+    cqMask = reinterpret_cast<unsigned*>(ring + params.cq_off.ring_mask);
+    cqes = ring + params.cq_off.cqes;
+}
+
+UringReader::~UringReader() {
+    if (sqeMemory) ::munmap(sqeMemory, sqeSize);
+    if (ringMemory) ::munmap(ringMemory, ringSize);
+    if (ringFd >= 0) ::close(ringFd);
+}
+
+bool UringReader::submitAndReap(std::vector<ReadRequest>& requests) {
+    auto* sqes = static_cast<io_uring_sqe*>(sqeMemory);
+    const auto* completions = static_cast<const io_uring_cqe*>(cqes);
+
+    size_t next = 0;
+    size_t inFlight = 0;
+
+    while (next < requests.size() || inFlight > 0) {
+        // Keep the queue as full as the ring allows; the completion ring is at least as large
+        unsigned tail = *sqTail;
+        const unsigned head = loadAcquire(sqHead);
+        while (next < requests.size() && tail - head < sqEntries && inFlight < sqEntries) {
+            const ReadRequest& request = requests[next];
+            const unsigned slot = tail & *sqMask;
+
+            io_uring_sqe& sqe = sqes[slot];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = request.fd;
+            sqe.off = request.offset;
+            sqe.addr = reinterpret_cast<uintptr_t>(request.buffer);
+            sqe.len = request.length;
+            sqe.user_data = next;
+            sqArray[slot] = slot;
+
+            ++tail;
+            ++next;
+            ++inFlight;
+        }
+        storeRelease(sqTail, tail);
+
+        const unsigned toSubmit = tail - loadAcquire(sqHead);
+        if (ioUringEnter(ringFd, toSubmit, 1, IORING_ENTER_GETEVENTS) < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+            return false;
+        }
+
+        unsigned completed = *cqHead;
+        const unsigned available = loadAcquire(cqTail);
+        for (; completed != available; ++completed) {
+            const io_uring_cqe& cqe = completions[completed & *cqMask];
+            requests[cqe.user_data].result = cqe.res;
+            --inFlight;
+        }
+        storeRelease(cqHead, completed);
+    }
+
+    return true;
+}
+
+#else
+
+bool UringReader::isSupported() {
+    return false;
+}
+
+UringReader::UringReader(unsigned) {}
+
+UringReader::~UringReader() = default;
+
+bool UringReader::submitAndReap(std::vector<ReadRequest>&) {
+    return false;
+}
+
+#endif // FABRICBINARYSEARCH_HAS_IO_URING
+
+bool UringReader::readAll(std::vector<ReadRequest>& requests) {
+    for (auto& request : requests) {
+        request.result = -ECANCELED;
+    }
+
+    if (isOpen()) {
+        submitAndReap(requests);
+    }
+
+    // Anything the ring didn't finish (old kernel without IORING_OP_READ, a short read,
+    // or a ring error) gets completed synchronously
+    bool allRead = true;
+    for (auto& request : requests) {
+        if (request.result == static_cast<int64_t>(request.length)) continue;
+
+        const size_t alreadyRead = request.result > 0 ? static_cast<size_t>(request.result) : 0;
+        if (!finishWithPread(request, alreadyRead)) {
+            allRead = false;
+        }
+    }
+
+    return allRead;
+}
+
+bool UringReader::finishWithPread(ReadRequest& request, size_t alreadyRead) {
+#ifdef _WIN32
+    (void)alreadyRead;
+    request.result = -ENOSYS;
+    return false;
+#else
+    size_t total = alreadyRead;
+    while (total < request.length) {
+        const ssize_t count = ::pread(request.fd, request.buffer + total, request.length - total,
+                                      static_cast<off_t>(request.offset + total));
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            request.result = -errno;
+            return false;
+        }
+        if (count == 0) break;
+        total += static_cast<size_t>(count);
+    }
+
+    request.result = static_cast<int64_t>(total);
+    return true;
+#endif
+}